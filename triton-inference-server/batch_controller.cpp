@@ -0,0 +1,144 @@
+#include "batch_controller.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+
+BatchController::BatchController(const BatchControllerConfig& config)
+    : config_(config) {
+    config_.min_batch = std::max(config_.min_batch, 1);
+    config_.max_batch = std::max(config_.max_batch, config_.min_batch);
+    config_.max_delay_us = std::max(config_.max_delay_us, config_.min_delay_us);
+    config_.latency_window = std::max<size_t>(config_.latency_window, 1);
+    batch_size_ = std::min(std::max(config_.initial_batch, config_.min_batch), config_.max_batch);
+    delay_us_ = std::min(std::max(config_.initial_delay_us, config_.min_delay_us), config_.max_delay_us);
+    latencies_.reserve(config_.latency_window);
+    metrics_.batch_size = batch_size_;
+    metrics_.delay_us = delay_us_;
+}
+
+void BatchController::ObserveDispatch(int items, size_t remaining) {
+    interval_dispatches_++;
+    interval_dispatched_items_ += items;
+    interval_backlog_ += remaining;
+}
+
+void BatchController::ObserveLatency(int64_t now_us, double latency_ms) {
+    if (last_update_us_ < 0) {
+        last_update_us_ = now_us;
+    }
+    if (latencies_.size() < config_.latency_window) {
+        latencies_.push_back(latency_ms);
+    } else {
+        latencies_[latency_head_] = latency_ms;
+        latency_head_ = (latency_head_ + 1) % config_.latency_window;
+    }
+    interval_completed_++;
+}
+
+double BatchController::WindowP99() const {
+    if (latencies_.empty()) {
+        return 0.0;
+    }
+    std::vector<double> sorted(latencies_);
+    size_t k = static_cast<size_t>(0.99 * (sorted.size() - 1));
+    std::nth_element(sorted.begin(), sorted.begin() + k, sorted.end());
+    return sorted[k];
+}
+
+bool BatchController::MaybeUpdate(int64_t now_us) {
+    if (last_update_us_ < 0 || now_us - last_update_us_ < config_.control_interval_us ||
+        interval_completed_ < config_.min_samples) {
+        return false;
+    }
+
+    const double elapsed_sec = (now_us - last_update_us_) / 1e6;
+    const double p99 = WindowP99();
+    const double mean_dispatch = interval_dispatches_ ?
+        static_cast<double>(interval_dispatched_items_) / interval_dispatches_ : 0.0;
+
+    const double mean_backlog = interval_dispatches_ ?
+        static_cast<double>(interval_backlog_) / interval_dispatches_ : 0.0;
+    const bool full = mean_dispatch >= batch_size_ * config_.full_ratio;
+    const bool backlog = mean_backlog >= batch_size_;
+
+    const int old_batch = batch_size_;
+    const int64_t old_delay = delay_us_;
+
+    if (p99 > config_.target_p99_ms) {
+        if (backlog && batch_size_ < config_.max_batch) {
+            // 请求堆积, 减小批只会进一步降低吞吐
+            batch_size_ = std::min(config_.max_batch, batch_size_ * 2);
+            metrics_.expansions++;
+        } else if (!full) {
+            delay_us_ = std::max(config_.min_delay_us,
+                                 static_cast<int64_t>(delay_us_ * config_.decrease_factor));
+            metrics_.delay_cuts++;
+        } else if (!backlog) {
+            // 乘性减
+            batch_size_ = std::max(config_.min_batch,
+                                   static_cast<int>(std::floor(batch_size_ * config_.decrease_factor)));
+            delay_us_ = std::max(config_.min_delay_us,
+                                 static_cast<int64_t>(delay_us_ * config_.decrease_factor));
+            metrics_.decreases++;
+        }
+    } else if (p99 < config_.target_p99_ms * config_.headroom) {
+        if (full) {
+            // 批经常凑满, 负载高: 加性增
+            batch_size_ = std::min(config_.max_batch, batch_size_ + config_.batch_step);
+            delay_us_ = std::min(config_.max_delay_us, delay_us_ + config_.delay_step_us);
+            metrics_.increases++;
+        } else if (delay_us_ > config_.min_delay_us) {
+            // 批凑不满, 等待只会增加延迟
+            delay_us_ = std::max(config_.min_delay_us,
+                                 static_cast<int64_t>(delay_us_ * config_.decrease_factor));
+            metrics_.delay_cuts++;
+        }
+    }
+
+    metrics_.batch_size = batch_size_;
+    metrics_.delay_us = delay_us_;
+    metrics_.observed_p99_ms = p99;
+    metrics_.throughput = interval_completed_ / elapsed_sec;
+    metrics_.mean_dispatch_size = mean_dispatch;
+    metrics_.mean_backlog = mean_backlog;
+    metrics_.updates++;
+
+    // 样本只反映本周期的决策
+    latencies_.clear();
+    latency_head_ = 0;
+    last_update_us_ = now_us;
+    interval_completed_ = 0;
+    interval_dispatches_ = 0;
+    interval_dispatched_items_ = 0;
+    interval_backlog_ = 0;
+    return batch_size_ != old_batch || delay_us_ != old_delay;
+}
+
+BatchControllerMetrics BatchController::Metrics() const {
+    return metrics_;
+}
+
+void BatchController::ExportPrometheus(std::ostream& os, const std::string& prefix) const {
+    os << "# TYPE " << prefix << "_size gauge\n"
+       << prefix << "_size " << metrics_.batch_size << "\n"
+       << "# TYPE " << prefix << "_delay_us gauge\n"
+       << prefix << "_delay_us " << metrics_.delay_us << "\n"
+       << "# TYPE " << prefix << "_target_p99_ms gauge\n"
+       << prefix << "_target_p99_ms " << config_.target_p99_ms << "\n"
+       << "# TYPE " << prefix << "_observed_p99_ms gauge\n"
+       << prefix << "_observed_p99_ms " << metrics_.observed_p99_ms << "\n"
+       << "# TYPE " << prefix << "_throughput gauge\n"
+       << prefix << "_throughput " << metrics_.throughput << "\n"
+       << "# TYPE " << prefix << "_mean_dispatch_size gauge\n"
+       << prefix << "_mean_dispatch_size " << metrics_.mean_dispatch_size << "\n"
+       << "# TYPE " << prefix << "_mean_backlog gauge\n"
+       << prefix << "_mean_backlog " << metrics_.mean_backlog << "\n"
+       << "# TYPE " << prefix << "_decisions_total counter\n"
+       << prefix << "_decisions_total{action=\"increase\"} " << metrics_.increases << "\n"
+       << prefix << "_decisions_total{action=\"expand\"} " << metrics_.expansions << "\n"
+       << prefix << "_decisions_total{action=\"decrease\"} " << metrics_.decreases << "\n"
+       << prefix << "_decisions_total{action=\"delay_cut\"} " << metrics_.delay_cuts << "\n"
+       << "# TYPE " << prefix << "_updates_total counter\n"
+       << prefix << "_updates_total " << metrics_.updates << "\n";
+}
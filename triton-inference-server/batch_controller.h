@@ -0,0 +1,84 @@
+#pragma once
+
+// 客户端自适应批处理控制器
+// 根据观测到的端到端延迟、实际批大小和积压, 用 AIMD 策略持续调整批大小和最大等待时间, 使 p99 保持在目标以内:
+//   p99 超标且有积压     -> 吞吐不足, 批大小翻倍以提高服务器效率
+//   p99 超标且批不满     -> 延迟来自攒批等待, 等待时间乘性减
+//   p99 超标且批满无积压 -> 大批的服务时间过长, 批大小和等待时间乘性减
+//   p99 有余量且批满     -> 批大小、等待时间加性增
+//   p99 有余量但批不满   -> 负载低, 缩短等待时间, 避免空等
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+struct BatchControllerConfig {
+    double target_p99_ms = 10.0;            // 端到端 p99 目标
+    int min_batch = 1;
+    int max_batch = 32;                     // 与 config.pbtxt 的 max_batch_size 一致
+    int64_t min_delay_us = 0;
+    int64_t max_delay_us = 20000;           // 与 max_queue_delay_microseconds 一致
+    int initial_batch = 8;
+    int64_t initial_delay_us = 2000;
+    int batch_step = 1;                     // 加性增: 批大小步长
+    int64_t delay_step_us = 250;            // 加性增: 等待时间步长
+    double decrease_factor = 0.5;           // 乘性减系数
+    double headroom = 0.8;                  // p99 低于 target * headroom 才允许增大
+    double full_ratio = 0.75;               // 平均实际批大小 / 批大小 达到此值视为批满
+    size_t latency_window = 512;            // 每个周期最多保留的延迟样本数
+    size_t min_samples = 32;                // 每个周期至少的样本数
+    int64_t control_interval_us = 100000;   // 调整周期
+};
+
+// 控制器对外暴露的指标
+struct BatchControllerMetrics {
+    int batch_size = 0;
+    int64_t delay_us = 0;
+    double observed_p99_ms = 0.0;
+    double throughput = 0.0;                // 最近一个周期的完成数/秒
+    double mean_dispatch_size = 0.0;        // 最近一个周期的平均实际批大小
+    double mean_backlog = 0.0;              // 最近一个周期下发后的平均积压
+    uint64_t increases = 0;
+    uint64_t expansions = 0;                // 因积压而翻倍批大小的次数
+    uint64_t decreases = 0;
+    uint64_t delay_cuts = 0;                // 因批不满而减小等待时间的次数
+    uint64_t updates = 0;
+};
+
+class BatchController {
+public:
+    explicit BatchController(const BatchControllerConfig& config = BatchControllerConfig());
+
+    // 记录一次实际下发的批大小, remaining 为下发后仍在排队的样本数
+    void ObserveDispatch(int items, size_t remaining = 0);
+    // 记录一个请求的端到端延迟(毫秒), now_us 为单调时钟微秒
+    void ObserveLatency(int64_t now_us, double latency_ms);
+    // 到达调整周期时更新决策, 决策变化时返回 true
+    bool MaybeUpdate(int64_t now_us);
+
+    int batch_size() const { return batch_size_; }
+    int64_t delay_us() const { return delay_us_; }
+    const BatchControllerConfig& config() const { return config_; }
+
+    BatchControllerMetrics Metrics() const;
+    // Prometheus 文本格式导出
+    void ExportPrometheus(std::ostream& os, const std::string& prefix = "track_batch") const;
+
+private:
+    double WindowP99() const;
+
+    BatchControllerConfig config_;
+    int batch_size_;
+    int64_t delay_us_;
+
+    std::vector<double> latencies_;         // 最近延迟样本的环形缓冲
+    size_t latency_head_ = 0;
+    size_t interval_completed_ = 0;
+    uint64_t interval_dispatches_ = 0;
+    uint64_t interval_dispatched_items_ = 0;
+    uint64_t interval_backlog_ = 0;
+    int64_t last_update_us_ = -1;
+
+    BatchControllerMetrics metrics_;
+};
@@ -0,0 +1,135 @@
+#include "batch_infer_client.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+
+namespace {
+
+// 一个切分后的请求, 输入输出对象在请求完成前必须保持有效
+struct Chunk {
+    size_t count = 0;
+    std::unique_ptr<tc::InferInput> input;
+    std::unique_ptr<tc::InferRequestedOutput> output;
+    std::vector<float> logits;
+    std::string error;
+};
+
+}  // namespace
+
+BatchInferClient::BatchInferClient(const std::string& url, TransportKind transport,
+                                   const BatchInferConfig& config, std::string* error)
+    : config_(config) {
+    config_.max_batch = std::max<size_t>(config_.max_batch, 1);
+    config_.max_in_flight = std::max<size_t>(config_.max_in_flight, 1);
+    tc::Error err;
+    transport_ = InferTransport::Create(transport, url, false, &err);
+    if (!transport_ && error) {
+        *error = err.Message();
+    }
+}
+
+bool BatchInferClient::Infer(const float* input, size_t count, std::vector<float>* output,
+                             std::string* error) {
+    output->clear();
+    if (!transport_) {
+        if (error) *error = "客户端未初始化";
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+
+    const size_t window_size = 20 * 14;
+    std::vector<Chunk> chunks((count + config_.max_batch - 1) / config_.max_batch);
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t in_flight = 0;
+    size_t completed = 0;
+
+    tc::InferOptions options(config_.model_name);
+    options.model_version_ = config_.model_version;
+
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        Chunk& chunk = chunks[i];
+        const size_t offset = i * config_.max_batch;
+        chunk.count = std::min(config_.max_batch, count - offset);
+
+        tc::InferInput* input_raw;
+        tc::Error err = tc::InferInput::Create(
+            &input_raw, config_.input_name, {static_cast<int64_t>(chunk.count), 20, 14}, "FP32");
+        if (err.IsOk()) {
+            chunk.input.reset(input_raw);
+            // 只记录指针, 发送时直接从调用方缓冲序列化
+            err = chunk.input->AppendRaw(reinterpret_cast<const uint8_t*>(input + offset * window_size),
+                                         chunk.count * window_size * sizeof(float));
+        }
+        tc::InferRequestedOutput* output_raw;
+        if (err.IsOk()) {
+            err = tc::InferRequestedOutput::Create(&output_raw, config_.output_name);
+        }
+        if (err.IsOk()) {
+            chunk.output.reset(output_raw);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return in_flight < config_.max_in_flight; });
+            in_flight++;
+        }
+
+        auto on_complete = [&, i](tc::InferResult* r) {
+            std::unique_ptr<tc::InferResult> result(r);
+            Chunk& done = chunks[i];
+            tc::Error status = result->RequestStatus();
+            const uint8_t* buffer = nullptr;
+            size_t byte_size = 0;
+            if (status.IsOk()) {
+                status = result->RawData(config_.output_name, &buffer, &byte_size);
+            }
+            if (status.IsOk()) {
+                const float* data = reinterpret_cast<const float*>(buffer);
+                done.logits.assign(data, data + byte_size / sizeof(float));
+            } else {
+                done.error = status.Message();
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            in_flight--;
+            completed++;
+            cv.notify_all();
+        };
+
+        if (err.IsOk()) {
+            err = transport_->AsyncInfer(on_complete, options, {chunk.input.get()}, {chunk.output.get()});
+        }
+        requests_.fetch_add(1, std::memory_order_relaxed);
+        if (!err.IsOk()) {
+            std::lock_guard<std::mutex> lock(mutex);
+            chunk.error = err.Message();
+            in_flight--;
+            completed++;
+        }
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return completed == chunks.size(); });
+    }
+
+    // 各请求的类别数必须一致, 以第一个请求为准
+    const size_t num_classes = chunks[0].count ? chunks[0].logits.size() / chunks[0].count : 0;
+    for (const Chunk& chunk : chunks) {
+        std::string reason = chunk.error;
+        if (reason.empty() && (num_classes == 0 || chunk.logits.size() != chunk.count * num_classes)) {
+            reason = "输出大小与批大小不符";
+        }
+        if (!reason.empty()) {
+            failures_.fetch_add(1, std::memory_order_relaxed);
+            if (error) *error = reason;
+            output->clear();
+            return false;
+        }
+        output->insert(output->end(), chunk.logits.begin(), chunk.logits.end());
+    }
+    return true;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+// 批量推理客户端: 把一次提交的 [N, 20, 14] 窗口按模型最大批大小切分, 通过传输层的异步接口
+// 同时保持多个在途请求, 全部返回后按原顺序拼接输出
+// 输入直接引用调用方缓冲(调用返回前必须保持有效), 不做拷贝; 供 Python 绑定等一次提交大量窗口的调用方使用
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "infer_transport.h"
+
+struct BatchInferConfig {
+    std::string model_name = "Times_Classify";
+    std::string model_version;          // 为空时由服务器按版本策略选择
+    std::string input_name = "input";
+    std::string output_name = "output";
+    size_t max_batch = 32;              // 单个请求的窗口数上限, 与 config.pbtxt 的 max_batch_size 一致
+    size_t max_in_flight = 4;           // 同时在途的请求数
+};
+
+class BatchInferClient {
+public:
+    // 创建失败时 IsValid() 为 false, 原因通过 error 返回
+    BatchInferClient(const std::string& url, TransportKind transport, const BatchInferConfig& config,
+                     std::string* error = nullptr);
+
+    BatchInferClient(const BatchInferClient&) = delete;
+    BatchInferClient& operator=(const BatchInferClient&) = delete;
+
+    bool IsValid() const { return transport_ != nullptr; }
+    const BatchInferConfig& config() const { return config_; }
+
+    // input 为行主序 [count, 20, 14], output 写入 [count, 类别数]
+    // 不打印日志, 失败时通过 error 返回第一个失败请求的原因; 可从多个线程同时调用
+    bool Infer(const float* input, size_t count, std::vector<float>* output,
+               std::string* error = nullptr);
+
+    // 发出的请求数和失败的调用数
+    uint64_t Requests() const { return requests_.load(std::memory_order_relaxed); }
+    uint64_t Failures() const { return failures_.load(std::memory_order_relaxed); }
+
+private:
+    BatchInferConfig config_;
+    std::unique_ptr<InferTransport> transport_;
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> failures_{0};
+};
@@ -0,0 +1,214 @@
+// 推理后端对比: 同一个 Times_Classify 模型分别在进程内 ONNX Runtime(CPU) 和本机 Triton 上推理,
+// 单个调用者逐个发送 [N, 20, 14] 请求, 统计各批大小下的 p50/p99 延迟和吞吐,
+// 并对同一输入比较两个后端的输出, 确认加载的是同一个模型
+//
+// 在仅有 CPU 的机器上对比时, Triton 的 instance_group 需要改为 KIND_CPU
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "infer_backend.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchConfig {
+    std::vector<BackendKind> backends = {BackendKind::kOnnxRuntime, BackendKind::kTriton};
+    InferBackendConfig backend;
+    std::vector<size_t> batch_sizes = {1, 2, 4, 8, 16, 32};
+    size_t requests = 2000;
+    size_t warmup = 100;
+};
+
+struct BenchResult {
+    double mean_ms = 0.0;
+    double p50_ms = 0.0;
+    double p99_ms = 0.0;
+    double windows_per_sec = 0.0;
+    size_t failures = 0;
+};
+
+double Percentile(std::vector<double> values, double q) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t k = static_cast<size_t>(q * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+std::vector<float> MakeInput(size_t batch_size) {
+    std::vector<float> data(batch_size * 20 * 14);
+    std::mt19937 gen(42);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    for (float& v : data) {
+        v = dist(gen);
+    }
+    return data;
+}
+
+BenchResult RunBatch(InferBackend* backend, const BenchConfig& config, size_t batch_size) {
+    BenchResult result;
+    std::vector<float> input = MakeInput(batch_size);
+    std::vector<float> output;
+    for (size_t i = 0; i < config.warmup; ++i) {
+        backend->InferBatch(input.data(), batch_size, &output);
+    }
+
+    std::vector<double> latencies_ms;
+    latencies_ms.reserve(config.requests);
+    auto start = Clock::now();
+    for (size_t i = 0; i < config.requests; ++i) {
+        auto begin = Clock::now();
+        if (!backend->InferBatch(input.data(), batch_size, &output)) {
+            result.failures++;
+            continue;
+        }
+        latencies_ms.push_back(std::chrono::duration<double, std::milli>(Clock::now() - begin).count());
+    }
+    double elapsed_sec = std::chrono::duration<double>(Clock::now() - start).count();
+
+    double sum = 0.0;
+    for (double v : latencies_ms) {
+        sum += v;
+    }
+    result.mean_ms = latencies_ms.empty() ? 0.0 : sum / latencies_ms.size();
+    result.p50_ms = Percentile(latencies_ms, 0.50);
+    result.p99_ms = Percentile(latencies_ms, 0.99);
+    result.windows_per_sec = latencies_ms.size() * batch_size / elapsed_sec;
+    return result;
+}
+
+void PrintUsage(const char* program_name) {
+    std::cout << "用法: " << program_name << " [选项]" << std::endl;
+    std::cout << "选项:" << std::endl;
+    std::cout << "  --backends LIST      逗号分隔, 默认 onnxruntime,triton" << std::endl;
+    std::cout << "  --onnx-model PATH    onnxruntime 加载的模型 (默认: model_repository/Times_Classify/1/Times_Classify.onnx)" << std::endl;
+    std::cout << "  --intra-threads N    onnxruntime 算子内线程数 (默认: 按物理核数)" << std::endl;
+    std::cout << "  --url URL            Triton 服务地址 (默认: http 为 localhost:8000, grpc 为 localhost:8001)" << std::endl;
+    std::cout << "  --protocol P         Triton 通信协议: http, grpc (默认: http)" << std::endl;
+    std::cout << "  --model MODEL        Triton 模型名称 (默认: Times_Classify)" << std::endl;
+    std::cout << "  --batches LIST       逗号分隔的批大小, 默认 1,2,4,8,16,32" << std::endl;
+    std::cout << "  --requests N         每组计时请求数 (默认: 2000)" << std::endl;
+}
+
+std::vector<std::string> SplitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        items.push_back(item);
+    }
+    return items;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--backends" && i + 1 < argc) {
+            config.backends.clear();
+            for (const std::string& name : SplitList(argv[++i])) {
+                BackendKind kind;
+                if (!ParseBackendKind(name, &kind)) {
+                    std::cerr << "未知后端: " << name << std::endl;
+                    return 1;
+                }
+                config.backends.push_back(kind);
+            }
+        } else if (arg == "--onnx-model" && i + 1 < argc) {
+            config.backend.onnx_path = argv[++i];
+        } else if (arg == "--intra-threads" && i + 1 < argc) {
+            config.backend.intra_op_threads = std::stoi(argv[++i]);
+        } else if (arg == "--url" && i + 1 < argc) {
+            config.backend.url = argv[++i];
+        } else if (arg == "--protocol" && i + 1 < argc) {
+            if (!ParseTransportKind(argv[++i], &config.backend.transport)) {
+                std::cerr << "未知协议: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "--model" && i + 1 < argc) {
+            config.backend.model_name = argv[++i];
+        } else if (arg == "--batches" && i + 1 < argc) {
+            config.batch_sizes.clear();
+            for (const std::string& item : SplitList(argv[++i])) {
+                config.batch_sizes.push_back(std::stoul(item));
+            }
+        } else if (arg == "--requests" && i + 1 < argc) {
+            config.requests = std::stoul(argv[++i]);
+        } else {
+            PrintUsage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    config.backend.max_batch = *std::max_element(config.batch_sizes.begin(), config.batch_sizes.end());
+
+    std::vector<std::unique_ptr<InferBackend>> backends;
+    for (BackendKind kind : config.backends) {
+        InferBackendConfig backend_config = config.backend;
+        backend_config.kind = kind;
+        std::unique_ptr<InferBackend> backend = InferBackend::Create(backend_config);
+        if (!backend || !backend->IsReady()) {
+            std::cerr << "⚠️  跳过后端 " << BackendKindName(kind) << std::endl;
+            continue;
+        }
+        backends.push_back(std::move(backend));
+    }
+    if (backends.empty()) {
+        return 1;
+    }
+
+    // 输出一致性: 以第一个后端为基准, 同一输入的 logits 最大绝对差
+    if (backends.size() > 1) {
+        const size_t batch_size = config.backend.max_batch;
+        std::vector<float> input = MakeInput(batch_size);
+        std::vector<float> reference;
+        std::vector<float> output;
+        if (backends[0]->InferBatch(input.data(), batch_size, &reference)) {
+            for (size_t b = 1; b < backends.size(); ++b) {
+                if (!backends[b]->InferBatch(input.data(), batch_size, &output) ||
+                    output.size() != reference.size()) {
+                    std::cerr << "⚠️  " << BackendKindName(backends[b]->Kind()) << " 输出形状不一致" << std::endl;
+                    continue;
+                }
+                float max_diff = 0.0f;
+                for (size_t i = 0; i < output.size(); ++i) {
+                    max_diff = std::max(max_diff, std::fabs(output[i] - reference[i]));
+                }
+                std::cout << "🔍 " << BackendKindName(backends[b]->Kind()) << " 与 "
+                          << BackendKindName(backends[0]->Kind()) << " 输出最大差值: "
+                          << std::scientific << std::setprecision(2) << max_diff << std::endl;
+            }
+        }
+    }
+
+    std::cout << std::left << std::setw(14) << "backend" << std::right
+              << std::setw(7) << "batch" << std::setw(11) << "mean ms"
+              << std::setw(10) << "p50 ms" << std::setw(10) << "p99 ms"
+              << std::setw(13) << "windows/s" << std::setw(10) << "failures" << std::endl;
+    for (const auto& backend : backends) {
+        for (size_t batch_size : config.batch_sizes) {
+            BenchResult result = RunBatch(backend.get(), config, batch_size);
+            std::cout << std::left << std::setw(14) << BackendKindName(backend->Kind()) << std::right
+                      << std::fixed << std::setw(7) << batch_size
+                      << std::setw(11) << std::setprecision(3) << result.mean_ms
+                      << std::setw(10) << result.p50_ms
+                      << std::setw(10) << result.p99_ms
+                      << std::setw(13) << std::setprecision(0) << result.windows_per_sec
+                      << std::setw(10) << result.failures << std::endl;
+        }
+    }
+    return 0;
+}
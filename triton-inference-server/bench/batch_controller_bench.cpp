@@ -0,0 +1,206 @@
+// 自适应批处理控制器验证: 离散事件模拟一个替身服务器, 分阶段注入不同的请求速率和服务器负载,
+// 对比静态配置(批大小 8, 等待 20ms, 即 config.pbtxt 的取值)与 BatchController 的 p99 和吞吐
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "batch_controller.h"
+
+namespace {
+
+struct Phase {
+    const char* name;
+    double duration_sec;
+    double arrival_rate;    // 请求/秒
+    double load_factor;     // 服务器被其他负载拖慢的倍数
+};
+
+// 替身服务器的服务时间: 固定开销 + 每个样本的开销
+struct ServerModel {
+    double base_us = 800.0;
+    double per_item_us = 60.0;
+
+    int64_t ServiceUs(int items, double load_factor) const {
+        return static_cast<int64_t>((base_us + per_item_us * items) * load_factor);
+    }
+};
+
+struct PhaseStats {
+    std::vector<double> latencies_ms;
+    uint64_t dispatches = 0;
+    uint64_t items = 0;
+    int final_batch = 0;
+    int64_t final_delay_us = 0;
+};
+
+double Percentile(std::vector<double> values, double q) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t k = static_cast<size_t>(q * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+std::vector<PhaseStats> Simulate(const std::vector<Phase>& phases, const ServerModel& server,
+                                 const BatchControllerConfig& config, bool adaptive) {
+    const int64_t kNever = std::numeric_limits<int64_t>::max();
+    BatchController controller(config);
+    std::mt19937 gen(7);
+
+    std::vector<int64_t> phase_end;
+    int64_t t_end = 0;
+    for (const Phase& phase : phases) {
+        t_end += static_cast<int64_t>(phase.duration_sec * 1e6);
+        phase_end.push_back(t_end);
+    }
+    auto PhaseAt = [&](int64_t t) {
+        size_t p = 0;
+        while (p + 1 < phase_end.size() && t >= phase_end[p]) {
+            ++p;
+        }
+        return p;
+    };
+
+    std::vector<PhaseStats> stats(phases.size());
+    std::deque<int64_t> client_queue;                   // 等待攒批的请求到达时间
+    std::deque<std::vector<int64_t>> server_queue;      // 已下发的批
+    std::vector<int64_t> in_service;
+    int64_t service_done = kNever;
+
+    auto NextArrival = [&](int64_t now) {
+        std::exponential_distribution<double> dist(phases[PhaseAt(now)].arrival_rate);
+        return now + std::max<int64_t>(1, static_cast<int64_t>(dist(gen) * 1e6));
+    };
+    auto StartService = [&](int64_t now) {
+        if (service_done != kNever || server_queue.empty()) {
+            return;
+        }
+        in_service = std::move(server_queue.front());
+        server_queue.pop_front();
+        service_done = now + server.ServiceUs(static_cast<int>(in_service.size()),
+                                              phases[PhaseAt(now)].load_factor);
+    };
+
+    int64_t now = 0;
+    int64_t next_arrival = NextArrival(0);
+    while (now < t_end || !client_queue.empty() || service_done != kNever) {
+        int batch_size = adaptive ? controller.batch_size() : config.initial_batch;
+        int64_t delay_us = adaptive ? controller.delay_us() : config.initial_delay_us;
+        int64_t deadline = (client_queue.empty() || service_done != kNever) ?
+            kNever : std::max(now, client_queue.front() + delay_us);
+        int64_t arrival = next_arrival < t_end ? next_arrival : kNever;
+        now = std::min({arrival, deadline, service_done});
+        if (now == kNever) {
+            break;
+        }
+
+        if (now == service_done) {
+            PhaseStats& phase = stats[PhaseAt(now)];
+            for (int64_t arrived : in_service) {
+                double latency_ms = (now - arrived) / 1000.0;
+                phase.latencies_ms.push_back(latency_ms);
+                controller.ObserveLatency(now, latency_ms);
+            }
+            service_done = kNever;
+            if (adaptive) {
+                controller.MaybeUpdate(now);
+            }
+            StartService(now);
+        }
+        if (now == arrival) {
+            client_queue.push_back(now);
+            next_arrival = NextArrival(now);
+        }
+
+        // 与流水线推理阶段一致, 同一时刻只有一个在途请求;
+        // 服务器空闲时, 攒够一批或最早请求等待超时则下发
+        batch_size = adaptive ? controller.batch_size() : config.initial_batch;
+        delay_us = adaptive ? controller.delay_us() : config.initial_delay_us;
+        if (service_done == kNever && !client_queue.empty() &&
+               (client_queue.size() >= static_cast<size_t>(batch_size) ||
+                now >= client_queue.front() + delay_us || now >= t_end)) {
+            size_t n = std::min(client_queue.size(), static_cast<size_t>(batch_size));
+            server_queue.emplace_back(client_queue.begin(), client_queue.begin() + n);
+            client_queue.erase(client_queue.begin(), client_queue.begin() + n);
+            controller.ObserveDispatch(static_cast<int>(n), client_queue.size());
+            PhaseStats& phase = stats[PhaseAt(now)];
+            phase.dispatches++;
+            phase.items += n;
+        }
+        StartService(now);
+
+        PhaseStats& phase = stats[PhaseAt(now)];
+        phase.final_batch = batch_size;
+        phase.final_delay_us = delay_us;
+    }
+
+    if (adaptive) {
+        std::cout << "\n控制器指标 (Prometheus):" << std::endl;
+        controller.ExportPrometheus(std::cout);
+    }
+    return stats;
+}
+
+void PrintStats(const char* policy, const std::vector<Phase>& phases,
+                const std::vector<PhaseStats>& stats) {
+    std::cout << "\n== " << policy << " ==" << std::endl;
+    std::cout << std::left << std::setw(16) << "phase" << std::right
+              << std::setw(10) << "p50 ms" << std::setw(10) << "p99 ms"
+              << std::setw(12) << "req/s" << std::setw(10) << "avg batch"
+              << std::setw(8) << "batch" << std::setw(10) << "delay us" << std::endl;
+    for (size_t p = 0; p < phases.size(); ++p) {
+        const PhaseStats& s = stats[p];
+        std::cout << std::left << std::setw(16) << phases[p].name << std::right << std::fixed
+                  << std::setw(10) << std::setprecision(2) << Percentile(s.latencies_ms, 0.50)
+                  << std::setw(10) << Percentile(s.latencies_ms, 0.99)
+                  << std::setw(12) << std::setprecision(0) << s.latencies_ms.size() / phases[p].duration_sec
+                  << std::setw(10) << std::setprecision(1)
+                  << (s.dispatches ? static_cast<double>(s.items) / s.dispatches : 0.0)
+                  << std::setw(8) << s.final_batch << std::setw(10) << s.final_delay_us << std::endl;
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    BatchControllerConfig config;
+    config.target_p99_ms = 10.0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--target-p99" && i + 1 < argc) {
+            config.target_p99_ms = std::stod(argv[++i]);
+        } else {
+            std::cout << "用法: " << argv[0] << " [--target-p99 MS]" << std::endl;
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    std::vector<Phase> phases = {
+        {"idle", 5.0, 300.0, 1.0},
+        {"high-rate", 5.0, 9000.0, 1.0},
+        {"contention", 5.0, 5000.0, 2.5},
+        {"recovered", 5.0, 2000.0, 1.0},
+    };
+    ServerModel server;
+
+    // 静态配置: 与 config.pbtxt 中 preferred_batch_size 8 / max_queue_delay 20ms 相当
+    BatchControllerConfig static_config = config;
+    static_config.initial_batch = 8;
+    static_config.initial_delay_us = 20000;
+    PrintStats("static batch=8 delay=20ms", phases,
+               Simulate(phases, server, static_config, false));
+
+    auto adaptive_stats = Simulate(phases, server, config, true);
+    PrintStats("adaptive (AIMD)", phases, adaptive_stats);
+    std::cout << "\np99 目标: " << config.target_p99_ms << " ms" << std::endl;
+    return 0;
+}
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""
+Python 客户端对比: 同一批 [N, 20, 14] 窗口分别用
+  1. client.py 的方式逐窗口调用 tritonclient.http
+  2. tritonclient.http 按 32 个窗口一批同步请求
+  3. tritonclient.http async_infer, 4 个在途请求
+  4. C++ 绑定 track_classify.Client.infer
+推理, 统计吞吐, 并用一个纯 Python 计数线程衡量推理期间其他线程还能拿到多少 GIL
+"""
+
+import argparse
+import os
+import sys
+import threading
+import time
+
+import numpy as np
+import tritonclient.http as httpclient
+
+
+class GilProbe:
+    """后台线程不断累加计数, 计数速率相对空闲时的比例即其他 Python 线程可用的 GIL 比例"""
+
+    def __init__(self):
+        self.count = 0
+        self.running = False
+        self.thread = None
+
+    def _run(self):
+        while self.running:
+            self.count += 1
+
+    def start(self):
+        self.count = 0
+        self.running = True
+        self.thread = threading.Thread(target=self._run, daemon=True)
+        self.thread.start()
+
+    def stop(self):
+        self.running = False
+        self.thread.join()
+        return self.count
+
+
+def measure(name, fn, windows, probe, idle_rate):
+    probe.start()
+    start = time.perf_counter()
+    outputs = fn(windows)
+    elapsed = time.perf_counter() - start
+    count = probe.stop()
+    gil_ratio = count / elapsed / idle_rate if idle_rate > 0 else 0.0
+    print(f"{name:<28}{len(windows):>8}{elapsed:>10.3f}{len(windows) / elapsed:>14.0f}{gil_ratio * 100:>11.1f}%")
+    return outputs
+
+
+def per_window(client, model):
+    """client.py 的做法: 每个窗口一个请求"""
+
+    def run(windows):
+        outputs = []
+        for window in windows:
+            data = np.expand_dims(window, axis=0)
+            inputs = [httpclient.InferInput("input", data.shape, "FP32")]
+            inputs[0].set_data_from_numpy(data)
+            result = client.infer(model_name=model, inputs=inputs,
+                                  outputs=[httpclient.InferRequestedOutput("output")])
+            outputs.append(result.as_numpy("output"))
+        return np.concatenate(outputs)
+
+    return run
+
+
+def batched(client, model, batch):
+    def run(windows):
+        outputs = []
+        for offset in range(0, len(windows), batch):
+            data = windows[offset:offset + batch]
+            inputs = [httpclient.InferInput("input", data.shape, "FP32")]
+            inputs[0].set_data_from_numpy(data)
+            result = client.infer(model_name=model, inputs=inputs,
+                                  outputs=[httpclient.InferRequestedOutput("output")])
+            outputs.append(result.as_numpy("output"))
+        return np.concatenate(outputs)
+
+    return run
+
+
+def batched_async(client, model, batch, in_flight):
+    def run(windows):
+        pending = []
+        outputs = []
+        for offset in range(0, len(windows), batch):
+            if len(pending) >= in_flight:
+                outputs.append(pending.pop(0).get_result().as_numpy("output"))
+            data = windows[offset:offset + batch]
+            inputs = [httpclient.InferInput("input", data.shape, "FP32")]
+            inputs[0].set_data_from_numpy(data)
+            pending.append(client.async_infer(model_name=model, inputs=inputs,
+                                              outputs=[httpclient.InferRequestedOutput("output")]))
+        outputs.extend(request.get_result().as_numpy("output") for request in pending)
+        return np.concatenate(outputs)
+
+    return run
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Python 客户端与 C++ 绑定的推理吞吐对比")
+    parser.add_argument("--url", default="localhost:8000", help="Triton 服务器地址 (HTTP)")
+    parser.add_argument("--model", default="Times_Classify", help="模型名称")
+    parser.add_argument("--windows", type=int, default=8192, help="每种方式推理的窗口数")
+    parser.add_argument("--per-window", type=int, default=1024,
+                        help="逐窗口方式只推理前 N 个窗口 (较慢)")
+    parser.add_argument("--batch", type=int, default=32, help="批大小, 与 config.pbtxt 的 max_batch_size 一致")
+    parser.add_argument("--in-flight", type=int, default=4, help="异步方式的在途请求数")
+    parser.add_argument("--module-dir", default="build", help="track_classify 模块所在目录")
+    args = parser.parse_args()
+
+    sys.path.insert(0, os.path.abspath(args.module_dir))
+    try:
+        import track_classify
+    except ImportError as e:
+        print(f"⚠️  无法导入 track_classify ({e}), 以 -DBUILD_PYTHON_MODULE=ON 构建后用 --module-dir 指定目录")
+        track_classify = None
+
+    rng = np.random.default_rng(42)
+    windows = rng.standard_normal((args.windows, 20, 14)).astype(np.float32)
+
+    client = httpclient.InferenceServerClient(url=args.url, concurrency=args.in_flight)
+    if not client.is_server_live():
+        print("❌ Triton 服务器未响应")
+        return 1
+
+    # 空闲时计数线程的速率作为基准
+    probe = GilProbe()
+    probe.start()
+    time.sleep(1.0)
+    idle_rate = probe.stop() / 1.0
+
+    print(f"{'method':<28}{'windows':>8}{'sec':>10}{'windows/s':>14}{'GIL free':>12}")
+    measure("client.py per-window", per_window(client, args.model),
+            windows[:args.per_window], probe, idle_rate)
+    reference = measure(f"tritonclient batch {args.batch}", batched(client, args.model, args.batch),
+                        windows, probe, idle_rate)
+    measure(f"tritonclient async x{args.in_flight}",
+            batched_async(client, args.model, args.batch, args.in_flight), windows, probe, idle_rate)
+
+    if track_classify is not None:
+        native = track_classify.Client(args.url, protocol="http", model=args.model,
+                                       max_batch=args.batch, max_in_flight=args.in_flight)
+        logits = measure(f"track_classify x{args.in_flight}", native.infer, windows, probe, idle_rate)
+        print(f"🔍 track_classify 与 tritonclient 输出最大差值: {np.max(np.abs(logits - reference)):.2e}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
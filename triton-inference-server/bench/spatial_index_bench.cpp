@@ -0,0 +1,309 @@
+// 航迹空间索引对比: 在一个雷达站周围生成散布目标和鸟群, 逐帧移动全部航迹并增量更新索引,
+// 对比 TrackSpatialIndex 与逐条线性扫描在半径查询、k 近邻查询上的耗时, 并校验两者结果一致
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "track_spatial_index.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchConfig {
+    std::vector<size_t> track_counts = {1000, 5000};
+    double cell_size = 500.0;
+    double area_km = 20.0;          // 目标分布在站点周围 ±area_km 的范围内
+    double flock_ratio = 0.3;       // 属于鸟群的目标比例
+    int frames = 20;
+    size_t queries = 20000;
+};
+
+// 站点本地东北天坐标与地心坐标的换算(站点纬度 30 度, 经度 114 度)
+struct LocalFrame {
+    double origin[3];
+    double east[3];
+    double north[3];
+    double up[3];
+
+    LocalFrame() {
+        const double kPi = 3.14159265358979323846;
+        const double lat = 30.0 * kPi / 180.0;
+        const double lon = 114.0 * kPi / 180.0;
+        const double radius = 6378137.0;
+        up[0] = std::cos(lat) * std::cos(lon);
+        up[1] = std::cos(lat) * std::sin(lon);
+        up[2] = std::sin(lat);
+        east[0] = -std::sin(lon);
+        east[1] = std::cos(lon);
+        east[2] = 0.0;
+        north[0] = -std::sin(lat) * std::cos(lon);
+        north[1] = -std::sin(lat) * std::sin(lon);
+        north[2] = std::cos(lat);
+        for (int i = 0; i < 3; ++i) {
+            origin[i] = up[i] * radius;
+        }
+    }
+
+    void ToEcef(double e, double n, double u, double* xyz) const {
+        for (int i = 0; i < 3; ++i) {
+            xyz[i] = origin[i] + east[i] * e + north[i] * n + up[i] * u;
+        }
+    }
+};
+
+struct Target {
+    TrackKey key;
+    double enu[3];
+    double vel[3];
+    double ecef[3];
+};
+
+std::vector<Target> MakeTargets(const BenchConfig& config, size_t count, std::mt19937* gen) {
+    const double area = config.area_km * 1000.0;
+    std::uniform_real_distribution<double> pos(-area, area);
+    std::uniform_real_distribution<double> alt(50.0, 3000.0);
+    std::uniform_real_distribution<double> heading(0.0, 6.283185307179586);
+    std::uniform_real_distribution<double> speed(5.0, 60.0);
+    std::normal_distribution<double> spread(0.0, 150.0);
+    std::uniform_int_distribution<int> flock_size(10, 40);
+
+    std::vector<Target> targets;
+    while (targets.size() < count) {
+        double e = pos(*gen);
+        double n = pos(*gen);
+        double u = alt(*gen);
+        double h = heading(*gen);
+        double v = speed(*gen);
+        // 鸟群: 同一片区域内若干只同向飞行的目标
+        int members = std::uniform_real_distribution<double>(0.0, 1.0)(*gen) < config.flock_ratio ?
+            flock_size(*gen) : 1;
+        for (int m = 0; m < members && targets.size() < count; ++m) {
+            Target t;
+            t.key = MakeTrackKey(static_cast<uint16>(1 + targets.size() / 60000), 0,
+                                 static_cast<uint16>(targets.size() % 60000));
+            t.enu[0] = members > 1 ? e + spread(*gen) : e;
+            t.enu[1] = members > 1 ? n + spread(*gen) : n;
+            t.enu[2] = members > 1 ? std::max(10.0, u + spread(*gen) * 0.3) : u;
+            t.vel[0] = v * std::sin(h);
+            t.vel[1] = v * std::cos(h);
+            t.vel[2] = 0.0;
+            targets.push_back(t);
+        }
+    }
+    return targets;
+}
+
+double ElapsedNs(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+// 线性扫描基线: 与 TrackFile 中逐条遍历航迹相当
+void LinearRadius(const std::vector<Target>& targets, const double* q, double radius,
+                  std::vector<TrackNeighbor>* out) {
+    const double r2 = radius * radius;
+    for (const Target& t : targets) {
+        double dx = t.ecef[0] - q[0];
+        double dy = t.ecef[1] - q[1];
+        double dz = t.ecef[2] - q[2];
+        double d2 = dx * dx + dy * dy + dz * dz;
+        if (d2 <= r2) {
+            out->push_back({t.key, d2});
+        }
+    }
+}
+
+void LinearNearest(const std::vector<Target>& targets, const double* q, size_t k,
+                   std::vector<TrackNeighbor>* out) {
+    out->clear();
+    for (const Target& t : targets) {
+        double dx = t.ecef[0] - q[0];
+        double dy = t.ecef[1] - q[1];
+        double dz = t.ecef[2] - q[2];
+        out->push_back({t.key, dx * dx + dy * dy + dz * dz});
+    }
+    k = std::min(k, out->size());
+    auto nearer = [](const TrackNeighbor& a, const TrackNeighbor& b) { return a.dist2 < b.dist2; };
+    std::partial_sort(out->begin(), out->begin() + k, out->end(), nearer);
+    out->resize(k);
+}
+
+struct QueryResult {
+    double index_ns = 0.0;
+    double linear_ns = 0.0;
+    double avg_hits = 0.0;
+    size_t mismatches = 0;
+};
+
+// kind: 半径查询时 param 为半径(米), k 近邻查询时 param 为 k
+QueryResult RunQueries(const TrackSpatialIndex& index, const std::vector<Target>& targets,
+                       const std::vector<std::vector<double>>& points, bool knn, double param) {
+    QueryResult result;
+    std::vector<TrackNeighbor> a;
+    std::vector<TrackNeighbor> b;
+    uint64_t hits = 0;
+
+    auto start = Clock::now();
+    for (const auto& q : points) {
+        if (knn) {
+            index.QueryNearest(q[0], q[1], q[2], static_cast<size_t>(param), &a);
+        } else {
+            a.clear();
+            index.QueryRadius(q[0], q[1], q[2], param, &a);
+        }
+        hits += a.size();
+    }
+    result.index_ns = ElapsedNs(start) / points.size();
+
+    start = Clock::now();
+    for (const auto& q : points) {
+        if (knn) {
+            LinearNearest(targets, q.data(), static_cast<size_t>(param), &b);
+        } else {
+            b.clear();
+            LinearRadius(targets, q.data(), param, &b);
+        }
+        hits += b.size();
+    }
+    result.linear_ns = ElapsedNs(start) / points.size();
+    result.avg_hits = hits / 2.0 / points.size();
+
+    // 校验: 半径查询比较命中集合, k 近邻比较距离序列(等距目标的键可能不同)
+    for (const auto& q : points) {
+        a.clear();
+        b.clear();
+        if (knn) {
+            index.QueryNearest(q[0], q[1], q[2], static_cast<size_t>(param), &a);
+            LinearNearest(targets, q.data(), static_cast<size_t>(param), &b);
+            bool same = a.size() == b.size();
+            for (size_t i = 0; same && i < a.size(); ++i) {
+                same = a[i].dist2 == b[i].dist2;
+            }
+            result.mismatches += same ? 0 : 1;
+        } else {
+            index.QueryRadius(q[0], q[1], q[2], param, &a);
+            LinearRadius(targets, q.data(), param, &b);
+            auto by_key = [](const TrackNeighbor& x, const TrackNeighbor& y) { return x.key < y.key; };
+            std::sort(a.begin(), a.end(), by_key);
+            std::sort(b.begin(), b.end(), by_key);
+            bool same = a.size() == b.size();
+            for (size_t i = 0; same && i < a.size(); ++i) {
+                same = a[i].key == b[i].key;
+            }
+            result.mismatches += same ? 0 : 1;
+        }
+    }
+    return result;
+}
+
+void RunScenario(const BenchConfig& config, size_t count) {
+    std::mt19937 gen(11);
+    LocalFrame frame;
+    std::vector<Target> targets = MakeTargets(config, count, &gen);
+
+    TrackSpatialIndexConfig index_config;
+    index_config.cell_size = config.cell_size;
+    index_config.bucket_count = count * 2;
+    TrackSpatialIndex index(index_config);
+
+    // 逐帧移动(数据率 1s), 与解码后调用 SaveTrack 的频率相同
+    double update_ns = 0.0;
+    for (int f = 0; f < config.frames; ++f) {
+        for (Target& t : targets) {
+            for (int i = 0; i < 3; ++i) {
+                t.enu[i] += t.vel[i];
+            }
+            frame.ToEcef(t.enu[0], t.enu[1], t.enu[2], t.ecef);
+        }
+        auto start = Clock::now();
+        for (const Target& t : targets) {
+            index.Update(t.key, t.ecef[0], t.ecef[1], t.ecef[2]);
+        }
+        update_ns += ElapsedNs(start);
+    }
+    update_ns /= double(config.frames) * targets.size();
+
+    // 查询点: 一半取在航迹位置上(鸟群聚类), 一半在区域内随机(威胁区中心)
+    const double area = config.area_km * 1000.0;
+    std::uniform_real_distribution<double> pos(-area, area);
+    std::uniform_int_distribution<size_t> pick(0, targets.size() - 1);
+    std::vector<std::vector<double>> points(config.queries, std::vector<double>(3));
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (i % 2 == 0) {
+            const Target& t = targets[pick(gen)];
+            points[i].assign(t.ecef, t.ecef + 3);
+        } else {
+            frame.ToEcef(pos(gen), pos(gen), 500.0, points[i].data());
+        }
+    }
+
+    std::cout << "\n== " << count << " 条航迹, 网格 " << config.cell_size << " m, 增量更新 "
+              << std::fixed << std::setprecision(1) << update_ns << " ns/航迹 ==" << std::endl;
+    std::cout << std::left << std::setw(16) << "query" << std::right << std::setw(12) << "avg hits"
+              << std::setw(14) << "index ns" << std::setw(14) << "linear ns"
+              << std::setw(10) << "speedup" << std::setw(12) << "mismatch" << std::endl;
+
+    struct Case {
+        const char* name;
+        bool knn;
+        double param;
+    };
+    const Case cases[] = {
+        {"radius 500m", false, 500.0},
+        {"radius 2km", false, 2000.0},
+        {"knn k=1", true, 1},
+        {"knn k=8", true, 8},
+    };
+    for (const Case& c : cases) {
+        QueryResult r = RunQueries(index, targets, points, c.knn, c.param);
+        std::cout << std::left << std::setw(16) << c.name << std::right << std::setprecision(1)
+                  << std::setw(12) << r.avg_hits << std::setw(14) << r.index_ns
+                  << std::setw(14) << r.linear_ns << std::setw(9) << r.linear_ns / r.index_ns << "x"
+                  << std::setw(12) << r.mismatches << std::endl;
+    }
+}
+
+std::vector<size_t> ParseList(const std::string& text) {
+    std::vector<size_t> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        values.push_back(std::stoul(item));
+    }
+    return values;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--tracks" && i + 1 < argc) {
+            config.track_counts = ParseList(argv[++i]);
+        } else if (arg == "--cell" && i + 1 < argc) {
+            config.cell_size = std::stod(argv[++i]);
+        } else if (arg == "--area-km" && i + 1 < argc) {
+            config.area_km = std::stod(argv[++i]);
+        } else if (arg == "--queries" && i + 1 < argc) {
+            config.queries = std::stoul(argv[++i]);
+        } else {
+            std::cout << "用法: " << argv[0]
+                      << " [--tracks 1000,5000] [--cell M] [--area-km KM] [--queries N]" << std::endl;
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    for (size_t count : config.track_counts) {
+        RunScenario(config, count);
+    }
+    return 0;
+}
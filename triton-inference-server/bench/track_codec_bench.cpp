@@ -0,0 +1,192 @@
+// 航迹报文解码对比: 同一批随机航迹分别用整体 memcpy(依赖主机字节序和位域布局)、字段描述生成的完整解码、
+// 只含流水线所需字段的部分解码解出, 再提取 14 维窗口特征, 统计每条航迹的耗时;
+// 小端和大端两种报文各测一遍, 并校验各种解码结果一致
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "track_message.h"
+#include "track_window.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchConfig {
+    size_t tracks = 1000;       // 每帧航迹数
+    int rounds = 2000;          // 每种方式重复解码的轮数
+};
+
+// 随机填充全部字段, 状态取 1(跟踪)
+std::vector<NetTrackItem_t> MakeItems(size_t count) {
+    std::mt19937 gen(7);
+    std::vector<NetTrackItem_t> items(count);
+    for (NetTrackItem_t& item : items) {
+        unsigned char* bytes = reinterpret_cast<unsigned char*>(&item);
+        for (size_t i = 0; i < sizeof(item); ++i) {
+            bytes[i] = static_cast<unsigned char>(gen());
+        }
+        item.status = 1;
+    }
+    return items;
+}
+
+template <WireEndian E>
+std::vector<char> EncodeItems(const std::vector<NetTrackItem_t>& items) {
+    std::vector<char> data(items.size() * sizeof(NetTrackItem_t));
+    for (size_t i = 0; i < items.size(); ++i) {
+        TrackItemSchema::Encode<E>(items[i], data.data() + i * sizeof(NetTrackItem_t));
+    }
+    return data;
+}
+
+void DecodeMemcpy(const char* data, size_t count, NetTrackItem_t* items) {
+    for (size_t i = 0; i < count; ++i) {
+        memcpy(&items[i], data + i * sizeof(NetTrackItem_t), sizeof(NetTrackItem_t));
+    }
+}
+
+template <typename Schema, WireEndian E>
+void DecodeSchema(const char* data, size_t count, NetTrackItem_t* items) {
+    for (size_t i = 0; i < count; ++i) {
+        Schema::template Decode<E>(data + i * sizeof(NetTrackItem_t), &items[i]);
+    }
+}
+
+struct CaseResult {
+    double decode_ns = 0.0;     // 每条航迹
+    double total_ns = 0.0;      // 解码 + 特征提取, 每条航迹
+    double checksum = 0.0;
+};
+
+using DecodeFn = void (*)(const char*, size_t, NetTrackItem_t*);
+
+CaseResult RunCase(DecodeFn decode, const std::vector<char>& data, size_t count, int rounds) {
+    CaseResult result;
+    std::vector<NetTrackItem_t> items(count);
+    std::vector<float> features(count * kFeatureDim);
+
+    auto start = Clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        decode(data.data(), count, items.data());
+        result.checksum += items[r % count].tgt_rng;
+    }
+    result.decode_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() /
+                       (double(rounds) * count);
+
+    start = Clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        decode(data.data(), count, items.data());
+        for (size_t i = 0; i < count; ++i) {
+            ExtractTrackFeatures(items[i], &features[i * kFeatureDim]);
+        }
+        result.checksum += features[(r % count) * kFeatureDim];
+    }
+    result.total_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() /
+                      (double(rounds) * count);
+    return result;
+}
+
+// 两种解码得到的 14 维特征逐条比较, 返回不一致的航迹数
+size_t CompareFeatures(const std::vector<NetTrackItem_t>& a, const std::vector<NetTrackItem_t>& b) {
+    size_t mismatches = 0;
+    float fa[kFeatureDim];
+    float fb[kFeatureDim];
+    for (size_t i = 0; i < a.size(); ++i) {
+        ExtractTrackFeatures(a[i], fa);
+        ExtractTrackFeatures(b[i], fb);
+        bool same = memcmp(fa, fb, sizeof(fa)) == 0 && a[i].status == b[i].status &&
+                    a[i].tgt_num == b[i].tgt_num && a[i].time == b[i].time &&
+                    a[i].tas_prd == b[i].tas_prd && a[i].tgt_species == b[i].tgt_species;
+        mismatches += same ? 0 : 1;
+    }
+    return mismatches;
+}
+
+void PrintUsage(const char* program_name) {
+    std::cout << "用法: " << program_name << " [选项]" << std::endl;
+    std::cout << "选项:" << std::endl;
+    std::cout << "  --tracks N    每帧航迹数 (默认: 1000)" << std::endl;
+    std::cout << "  --rounds N    每种方式重复解码的轮数 (默认: 2000)" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--tracks" && i + 1 < argc) {
+            config.tracks = std::max<size_t>(std::stoul(argv[++i]), 1);
+        } else if (arg == "--rounds" && i + 1 < argc) {
+            config.rounds = std::max(std::stoi(argv[++i]), 1);
+        } else {
+            PrintUsage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    const bool host_little = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+    const size_t count = config.tracks;
+    std::vector<NetTrackItem_t> items = MakeItems(count);
+    std::vector<char> little = EncodeItems<WireEndian::kLittle>(items);
+    std::vector<char> big = EncodeItems<WireEndian::kBig>(items);
+
+    // 校验: 完整解码还原原结构体, 部分解码的特征与完整解码一致, 小端主机上 memcpy 与小端解码一致
+    size_t failures = 0;
+    std::vector<NetTrackItem_t> full(count);
+    std::vector<NetTrackItem_t> partial(count);
+    DecodeSchema<TrackItemSchema, WireEndian::kLittle>(little.data(), count, full.data());
+    failures += memcmp(full.data(), items.data(), count * sizeof(NetTrackItem_t)) != 0;
+    DecodeSchema<TrackItemSchema, WireEndian::kBig>(big.data(), count, full.data());
+    failures += memcmp(full.data(), items.data(), count * sizeof(NetTrackItem_t)) != 0;
+    DecodeSchema<TrackFeatureSchema, WireEndian::kBig>(big.data(), count, partial.data());
+    failures += CompareFeatures(full, partial) != 0;
+    if (host_little) {
+        DecodeMemcpy(little.data(), count, partial.data());
+        failures += memcmp(partial.data(), items.data(), count * sizeof(NetTrackItem_t)) != 0;
+    }
+    if (failures > 0) {
+        std::cerr << "❌ 解码结果不一致 (" << failures << " 项校验失败)" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ 小端/大端完整解码还原一致, 部分解码特征一致" << std::endl;
+
+    struct Case {
+        const char* name;
+        DecodeFn decode;
+        const std::vector<char>* data;
+    };
+    std::vector<Case> cases;
+    if (host_little) {
+        cases.push_back({"memcpy (host)", DecodeMemcpy, &little});
+    }
+    cases.push_back({"schema full LE", DecodeSchema<TrackItemSchema, WireEndian::kLittle>, &little});
+    cases.push_back({"schema feature LE", DecodeSchema<TrackFeatureSchema, WireEndian::kLittle>, &little});
+    cases.push_back({"schema full BE", DecodeSchema<TrackItemSchema, WireEndian::kBig>, &big});
+    cases.push_back({"schema feature BE", DecodeSchema<TrackFeatureSchema, WireEndian::kBig>, &big});
+
+    std::cout << "\n== " << count << " 条航迹 x " << config.rounds << " 轮 ==" << std::endl;
+    std::cout << std::left << std::setw(20) << "decoder" << std::right
+              << std::setw(14) << "decode ns" << std::setw(18) << "+features ns" << std::endl;
+    double checksum = 0.0;
+    for (const Case& c : cases) {
+        CaseResult result = RunCase(c.decode, *c.data, count, config.rounds);
+        checksum += result.checksum;
+        std::cout << std::left << std::setw(20) << c.name << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(14) << result.decode_ns
+                  << std::setw(18) << result.total_ns << std::endl;
+    }
+    // 防止编译器消除解码循环
+    if (checksum == 0.123) {
+        std::cout << checksum << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,257 @@
+// 传输协议对比: 对同一个模型分别用 HTTP、gRPC、gRPC 双向流发送 [N, 20, 14] 的请求,
+// 保持固定数量的在途请求, 统计各批大小下的吞吐和端到端延迟
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "infer_transport.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchConfig {
+    std::string http_url = "localhost:8000";
+    std::string grpc_url = "localhost:8001";
+    std::string model_name = "Times_Classify";
+    std::vector<TransportKind> protocols = {TransportKind::kHttp, TransportKind::kGrpc,
+                                            TransportKind::kGrpcStream};
+    std::vector<size_t> batch_sizes = {1, 4, 8, 16, 32};
+    size_t requests = 2000;
+    size_t warmup = 50;
+    size_t concurrency = 4;
+};
+
+struct BenchResult {
+    double requests_per_sec = 0.0;
+    double windows_per_sec = 0.0;
+    double p50_ms = 0.0;
+    double p99_ms = 0.0;
+    size_t failures = 0;
+};
+
+// 一个在途请求槽位: 输入在请求完成前必须保持有效
+struct Slot {
+    std::unique_ptr<tc::InferInput> input;
+    std::unique_ptr<tc::InferRequestedOutput> output;
+    Clock::time_point start;
+};
+
+double Percentile(std::vector<double> values, double q) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t k = static_cast<size_t>(q * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+bool RunBatch(InferTransport* transport, const BenchConfig& config, size_t batch_size,
+              BenchResult* result) {
+    std::vector<float> data(batch_size * 20 * 14);
+    std::mt19937 gen(42);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    for (float& v : data) {
+        v = dist(gen);
+    }
+
+    std::vector<Slot> slots(config.concurrency);
+    for (Slot& slot : slots) {
+        tc::InferInput* input;
+        tc::Error err = tc::InferInput::Create(
+            &input, "input", {static_cast<int64_t>(batch_size), 20, 14}, "FP32");
+        if (!err.IsOk()) {
+            std::cerr << "❌ 创建输入失败: " << err << std::endl;
+            return false;
+        }
+        slot.input.reset(input);
+        err = slot.input->AppendRaw(reinterpret_cast<const uint8_t*>(data.data()),
+                                    data.size() * sizeof(float));
+        if (!err.IsOk()) {
+            std::cerr << "❌ 设置输入数据失败: " << err << std::endl;
+            return false;
+        }
+        tc::InferRequestedOutput* output;
+        err = tc::InferRequestedOutput::Create(&output, "output");
+        if (!err.IsOk()) {
+            std::cerr << "❌ 创建输出失败: " << err << std::endl;
+            return false;
+        }
+        slot.output.reset(output);
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<size_t> free_slots;
+    for (size_t i = 0; i < slots.size(); ++i) {
+        free_slots.push_back(i);
+    }
+    std::vector<double> latencies_ms;
+    latencies_ms.reserve(config.requests);
+    size_t failures = 0;
+    size_t completed = 0;
+
+    const size_t total = config.warmup + config.requests;
+    tc::InferOptions options(config.model_name);
+    Clock::time_point measure_start = Clock::now();
+
+    for (size_t sent = 0; sent < total; ++sent) {
+        size_t index;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return !free_slots.empty(); });
+            index = free_slots.back();
+            free_slots.pop_back();
+            if (sent == config.warmup) {
+                // 预热请求全部返回后才开始计时
+                cv.wait(lock, [&] { return completed == config.warmup; });
+                measure_start = Clock::now();
+            }
+        }
+
+        const bool measured = sent >= config.warmup;
+        Slot& slot = slots[index];
+        slot.start = Clock::now();
+        auto on_complete = [&, index, measured](tc::InferResult* r) {
+            std::unique_ptr<tc::InferResult> result_ptr(r);
+            const uint8_t* buffer;
+            size_t byte_size;
+            bool ok = result_ptr->RequestStatus().IsOk() &&
+                      result_ptr->RawData("output", &buffer, &byte_size).IsOk();
+            double latency_ms = std::chrono::duration<double, std::milli>(
+                Clock::now() - slots[index].start).count();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (measured) {
+                if (ok) {
+                    latencies_ms.push_back(latency_ms);
+                } else {
+                    failures++;
+                }
+            }
+            completed++;
+            free_slots.push_back(index);
+            cv.notify_all();
+        };
+
+        tc::Error err = transport->AsyncInfer(on_complete, options, {slot.input.get()},
+                                              {slot.output.get()});
+        if (!err.IsOk()) {
+            std::cerr << "❌ 发送请求失败: " << err << std::endl;
+            std::lock_guard<std::mutex> lock(mutex);
+            failures += measured ? 1 : 0;
+            completed++;
+            free_slots.push_back(index);
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return completed == total; });
+    double elapsed_sec = std::chrono::duration<double>(Clock::now() - measure_start).count();
+
+    result->requests_per_sec = latencies_ms.size() / elapsed_sec;
+    result->windows_per_sec = result->requests_per_sec * batch_size;
+    result->p50_ms = Percentile(latencies_ms, 0.50);
+    result->p99_ms = Percentile(latencies_ms, 0.99);
+    result->failures = failures;
+    return true;
+}
+
+void PrintUsage(const char* program_name) {
+    std::cout << "用法: " << program_name << " [选项]" << std::endl;
+    std::cout << "选项:" << std::endl;
+    std::cout << "  --http-url URL       HTTP 服务地址 (默认: localhost:8000)" << std::endl;
+    std::cout << "  --grpc-url URL       gRPC 服务地址 (默认: localhost:8001)" << std::endl;
+    std::cout << "  --model MODEL        模型名称 (默认: Times_Classify)" << std::endl;
+    std::cout << "  --protocols LIST     逗号分隔, 默认 http,grpc,grpc-stream" << std::endl;
+    std::cout << "  --batches LIST       逗号分隔的批大小, 默认 1,4,8,16,32" << std::endl;
+    std::cout << "  --requests N         每组计时请求数 (默认: 2000)" << std::endl;
+    std::cout << "  --concurrency N      在途请求数 (默认: 4)" << std::endl;
+}
+
+std::vector<std::string> SplitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        items.push_back(item);
+    }
+    return items;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--http-url" && i + 1 < argc) {
+            config.http_url = argv[++i];
+        } else if (arg == "--grpc-url" && i + 1 < argc) {
+            config.grpc_url = argv[++i];
+        } else if (arg == "--model" && i + 1 < argc) {
+            config.model_name = argv[++i];
+        } else if (arg == "--protocols" && i + 1 < argc) {
+            config.protocols.clear();
+            for (const std::string& name : SplitList(argv[++i])) {
+                TransportKind kind;
+                if (!ParseTransportKind(name, &kind)) {
+                    std::cerr << "未知协议: " << name << std::endl;
+                    return 1;
+                }
+                config.protocols.push_back(kind);
+            }
+        } else if (arg == "--batches" && i + 1 < argc) {
+            config.batch_sizes.clear();
+            for (const std::string& item : SplitList(argv[++i])) {
+                config.batch_sizes.push_back(std::stoul(item));
+            }
+        } else if (arg == "--requests" && i + 1 < argc) {
+            config.requests = std::stoul(argv[++i]);
+        } else if (arg == "--concurrency" && i + 1 < argc) {
+            config.concurrency = std::max<size_t>(1, std::stoul(argv[++i]));
+        } else {
+            PrintUsage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    std::cout << std::left << std::setw(14) << "protocol" << std::right
+              << std::setw(7) << "batch" << std::setw(11) << "req/s"
+              << std::setw(13) << "windows/s" << std::setw(10) << "p50 ms"
+              << std::setw(10) << "p99 ms" << std::setw(10) << "failures" << std::endl;
+
+    for (TransportKind kind : config.protocols) {
+        const std::string& url = kind == TransportKind::kHttp ? config.http_url : config.grpc_url;
+        tc::Error err;
+        std::unique_ptr<InferTransport> transport = InferTransport::Create(kind, url, false, &err);
+        if (!transport) {
+            std::cerr << "❌ 创建客户端失败 (" << TransportKindName(kind) << "): " << err << std::endl;
+            continue;
+        }
+        for (size_t batch_size : config.batch_sizes) {
+            BenchResult result;
+            if (!RunBatch(transport.get(), config, batch_size, &result)) {
+                return 1;
+            }
+            std::cout << std::left << std::setw(14) << TransportKindName(kind) << std::right
+                      << std::fixed << std::setw(7) << batch_size
+                      << std::setw(11) << std::setprecision(0) << result.requests_per_sec
+                      << std::setw(13) << result.windows_per_sec
+                      << std::setw(10) << std::setprecision(2) << result.p50_ms
+                      << std::setw(10) << result.p99_ms
+                      << std::setw(10) << result.failures << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,237 @@
+#include "hedged_client.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+
+namespace {
+
+// 样本不足时的对冲等待时间
+constexpr int64_t kInitialHedgeDelayUs = 50000;
+// 至少积累这么多样本后才按分位数计算对冲等待时间
+constexpr size_t kMinLatencySamples = 32;
+// 每积累这么多新样本重新计算一次分位数
+constexpr size_t kHedgeDelayRefresh = 64;
+
+using Clock = std::chrono::steady_clock;
+
+}  // namespace
+
+struct HedgedInferClient::Target {
+    HedgeTarget info;
+    std::unique_ptr<InferTransport> client;
+};
+
+// 一次逻辑推理调用, 由主请求与对冲请求的回调共享
+struct HedgedInferClient::Call {
+    std::vector<float> input;           // 落后的请求可能在 Infer 返回后仍在途, 自持输入拷贝
+    size_t batch_size = 0;
+    std::vector<std::shared_ptr<tc::InferInput>> inputs;
+    std::vector<std::shared_ptr<tc::InferRequestedOutput>> outputs;
+    Clock::time_point start;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+    int winner = -1;
+    int outstanding = 0;
+    std::vector<float> output;
+};
+
+HedgedInferClient::HedgedInferClient(const std::vector<HedgeTarget>& targets,
+                                     const HedgeConfig& config, bool verbose)
+    : config_(config),
+      hedge_delay_us_(kInitialHedgeDelayUs),
+      budget_tokens_(config.budget_burst) {
+    config_.latency_window = std::max<size_t>(config_.latency_window, kMinLatencySamples);
+    for (const HedgeTarget& info : targets) {
+        std::unique_ptr<Target> target(new Target());
+        target->info = info;
+        tc::Error err;
+        target->client = InferTransport::Create(info.transport, info.url, verbose, &err);
+        if (!target->client) {
+            std::cerr << "❌ 创建客户端失败 (" << info.url << "): " << err << std::endl;
+            targets_.clear();
+            return;
+        }
+        targets_.push_back(std::move(target));
+    }
+    latencies_us_.reserve(config_.latency_window);
+}
+
+HedgedInferClient::~HedgedInferClient() {
+    // 先销毁客户端, 等待其工作线程退出, 之后不会再有回调访问本对象
+    targets_.clear();
+}
+
+bool HedgedInferClient::Send(size_t target_index, const std::shared_ptr<Call>& call, int attempt) {
+    Target& target = *targets_[target_index];
+    std::vector<int64_t> shape = {static_cast<int64_t>(call->batch_size), 20, 14};
+
+    tc::InferInput* input_raw;
+    tc::Error err = tc::InferInput::Create(&input_raw, target.info.input_name, shape, "FP32");
+    if (!err.IsOk()) {
+        std::cerr << "❌ 创建输入失败: " << err << std::endl;
+        return false;
+    }
+    std::shared_ptr<tc::InferInput> input(input_raw);
+    err = input->AppendRaw(reinterpret_cast<const uint8_t*>(call->input.data()),
+                           call->input.size() * sizeof(float));
+    if (!err.IsOk()) {
+        std::cerr << "❌ 设置输入数据失败: " << err << std::endl;
+        return false;
+    }
+
+    tc::InferRequestedOutput* output_raw;
+    err = tc::InferRequestedOutput::Create(&output_raw, target.info.output_name);
+    if (!err.IsOk()) {
+        std::cerr << "❌ 创建输出失败: " << err << std::endl;
+        return false;
+    }
+    std::shared_ptr<tc::InferRequestedOutput> output(output_raw);
+
+    call->inputs.push_back(input);
+    call->outputs.push_back(output);
+    {
+        std::lock_guard<std::mutex> lock(call->mutex);
+        call->outstanding++;
+    }
+
+    tc::InferOptions options(target.info.model_name);
+    // 客户端不支持取消在途请求, 用客户端超时限制落后请求占用连接的时间
+    options.client_timeout_ = config_.request_timeout_us;
+
+    const std::string& output_name = target.info.output_name;
+    auto on_complete = [call, attempt, output_name](tc::InferResult* result) {
+        std::unique_ptr<tc::InferResult> result_ptr(result);
+        const uint8_t* buffer = nullptr;
+        size_t byte_size = 0;
+        bool ok = result_ptr->RequestStatus().IsOk() &&
+                  result_ptr->RawData(output_name, &buffer, &byte_size).IsOk();
+
+        std::lock_guard<std::mutex> lock(call->mutex);
+        call->outstanding--;
+        if (ok && !call->done) {
+            const float* data = reinterpret_cast<const float*>(buffer);
+            call->output.assign(data, data + byte_size / sizeof(float));
+            call->done = true;
+            call->winner = attempt;
+        }
+        call->cv.notify_all();
+    };
+
+    err = target.client->AsyncInfer(on_complete, options, {input.get()}, {output.get()});
+    if (!err.IsOk()) {
+        std::cerr << "❌ 发送请求失败 (" << target.info.model_name << "): " << err << std::endl;
+        std::lock_guard<std::mutex> lock(call->mutex);
+        call->outstanding--;
+        return false;
+    }
+    return true;
+}
+
+int64_t HedgedInferClient::HedgeDelayUs() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (latencies_us_.size() >= kMinLatencySamples && samples_since_update_ >= kHedgeDelayRefresh) {
+        std::vector<int64_t> sorted(latencies_us_);
+        size_t k = static_cast<size_t>(config_.hedge_percentile * (sorted.size() - 1));
+        std::nth_element(sorted.begin(), sorted.begin() + k, sorted.end());
+        hedge_delay_us_ = std::max(config_.min_hedge_delay_us, sorted[k]);
+        samples_since_update_ = 0;
+    }
+    stats_.hedge_delay_us = hedge_delay_us_;
+    return hedge_delay_us_;
+}
+
+void HedgedInferClient::RecordLatency(int64_t latency_us) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (latencies_us_.size() < config_.latency_window) {
+        latencies_us_.push_back(latency_us);
+    } else {
+        latencies_us_[latency_head_] = latency_us;
+        latency_head_ = (latency_head_ + 1) % config_.latency_window;
+    }
+    samples_since_update_++;
+}
+
+bool HedgedInferClient::TakeBudget() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (budget_tokens_ < 1.0) {
+        stats_.budget_denied++;
+        return false;
+    }
+    budget_tokens_ -= 1.0;
+    stats_.hedges_sent++;
+    return true;
+}
+
+bool HedgedInferClient::Infer(const float* input, size_t batch_size, std::vector<float>* output) {
+    if (targets_.empty() || batch_size == 0) return false;
+
+    auto call = std::make_shared<Call>();
+    call->input.assign(input, input + batch_size * 20 * 14);
+    call->batch_size = batch_size;
+    call->start = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.requests++;
+        // 每个主请求为预算补充 budget_ratio 个令牌
+        budget_tokens_ = std::min(config_.budget_burst, budget_tokens_ + config_.budget_ratio);
+    }
+
+    const int64_t hedge_delay_us = HedgeDelayUs();
+    const auto hedge_deadline = call->start + std::chrono::microseconds(hedge_delay_us);
+    const auto timeout_deadline = call->start + std::chrono::microseconds(config_.request_timeout_us);
+    Send(0, call, 0);
+
+    std::unique_lock<std::mutex> lock(call->mutex);
+    bool hedged = false;
+    while (!call->done) {
+        if (!hedged) {
+            // 主请求失败或超过对冲等待时间: 向下一个对冲目标发送一次
+            if (call->outstanding == 0 || Clock::now() >= hedge_deadline) {
+                hedged = true;
+                if (targets_.size() > 1) {
+                    size_t target_index = 1 + next_hedge_++ % (targets_.size() - 1);
+                    lock.unlock();
+                    if (TakeBudget()) {
+                        Send(target_index, call, 1);
+                    }
+                    lock.lock();
+                }
+                continue;
+            }
+            call->cv.wait_until(lock, hedge_deadline);
+        } else {
+            if (call->outstanding == 0 ||
+                call->cv.wait_until(lock, timeout_deadline) == std::cv_status::timeout) {
+                break;
+            }
+        }
+    }
+
+    const bool ok = call->done;
+    const int winner = call->winner;
+    if (ok) {
+        output->swap(call->output);
+    }
+    lock.unlock();
+
+    if (ok) {
+        RecordLatency(std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - call->start).count());
+    }
+    std::lock_guard<std::mutex> stats_lock(mutex_);
+    if (!ok) {
+        stats_.failures++;
+    } else if (winner > 0) {
+        stats_.hedge_wins++;
+    }
+    return ok;
+}
+
+HedgeStats HedgedInferClient::Stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
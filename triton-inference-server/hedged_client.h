@@ -0,0 +1,82 @@
+#pragma once
+
+// 对冲请求: 主请求在最近延迟的某个分位数内未完成时, 向另一个端点或模型变体
+// (如 Times_Classify_TRT_DYNAMIC 与 Times_Classify)发送相同的请求, 先返回者胜出,
+// 落后的请求结果被丢弃; 对冲请求数受预算限制, 只占总请求的百分之几
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "infer_transport.h"
+
+struct HedgeTarget {
+    std::string url;
+    std::string model_name;
+    TransportKind transport = TransportKind::kHttp;
+    // 不同后端导出的模型张量名可能不同, 热启动时由各自的模型元数据填入
+    std::string input_name = "input";
+    std::string output_name = "output";
+};
+
+struct HedgeConfig {
+    double hedge_percentile = 0.95;         // 超过最近延迟的该分位数仍未完成时发出对冲
+    int64_t min_hedge_delay_us = 1000;      // 对冲等待时间下限
+    double budget_ratio = 0.05;             // 对冲请求数占主请求数的上限
+    double budget_burst = 10.0;             // 预算令牌桶容量, 允许短时集中对冲
+    size_t latency_window = 1024;           // 统计分位数的最近样本数
+    uint64_t request_timeout_us = 1000000;  // 单个请求的客户端超时
+};
+
+struct HedgeStats {
+    uint64_t requests = 0;
+    uint64_t hedges_sent = 0;
+    uint64_t hedge_wins = 0;                // 对冲请求先返回的次数
+    uint64_t budget_denied = 0;             // 达到对冲条件但预算不足的次数
+    uint64_t failures = 0;
+    int64_t hedge_delay_us = 0;             // 当前对冲等待时间
+};
+
+class HedgedInferClient {
+public:
+    // targets[0] 为主目标, 其余为对冲目标, 按顺序轮流使用
+    HedgedInferClient(const std::vector<HedgeTarget>& targets,
+                      const HedgeConfig& config = HedgeConfig(), bool verbose = false);
+    ~HedgedInferClient();
+
+    HedgedInferClient(const HedgedInferClient&) = delete;
+    HedgedInferClient& operator=(const HedgedInferClient&) = delete;
+
+    bool IsValid() const { return !targets_.empty(); }
+
+    // 阻塞推理, 与 InferFn 签名一致
+    // input 为 [batch_size, 20, 14], output 写入 [batch_size, 类别数]
+    bool Infer(const float* input, size_t batch_size, std::vector<float>* output);
+
+    HedgeStats Stats() const;
+
+private:
+    struct Target;
+    struct Call;
+
+    // 在 target 上异步发送 call 的请求, attempt 为尝试序号(0 为主请求)
+    bool Send(size_t target_index, const std::shared_ptr<Call>& call, int attempt);
+    int64_t HedgeDelayUs();
+    void RecordLatency(int64_t latency_us);
+    bool TakeBudget();
+
+    HedgeConfig config_;
+    std::vector<std::unique_ptr<Target>> targets_;
+    std::atomic<size_t> next_hedge_{0};
+
+    mutable std::mutex mutex_;              // 保护延迟样本、预算和统计
+    std::vector<int64_t> latencies_us_;
+    size_t latency_head_ = 0;
+    size_t samples_since_update_ = 0;
+    int64_t hedge_delay_us_;
+    double budget_tokens_;
+    HedgeStats stats_;
+};
@@ -0,0 +1,245 @@
+#include "infer_backend.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+#ifdef ENABLE_ONNXRUNTIME
+#include <onnxruntime_cxx_api.h>
+#endif
+
+#include "triton_client.h"
+
+bool ParseBackendKind(const std::string& name, BackendKind* kind) {
+    if (name == "triton") {
+        *kind = BackendKind::kTriton;
+    } else if (name == "onnxruntime") {
+        *kind = BackendKind::kOnnxRuntime;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* BackendKindName(BackendKind kind) {
+    switch (kind) {
+        case BackendKind::kTriton: return "triton";
+        case BackendKind::kOnnxRuntime: return "onnxruntime";
+    }
+    return "unknown";
+}
+
+bool InferBackend::PredictWithLabels(const std::vector<float>& input_data,
+                                     const std::vector<std::string>& labels) {
+    if (input_data.size() != 20 * 14) {
+        std::cerr << "❌ 输入数据大小应为 20x14, 实际为 " << input_data.size() << std::endl;
+        return false;
+    }
+    std::cout << "📥 输入数据形状: [1, 20, 14] (" << BackendKindName(Kind()) << ")" << std::endl;
+
+    std::vector<float> raw_output;
+    auto start_time = std::chrono::steady_clock::now();
+    if (!InferBatch(input_data.data(), 1, &raw_output) || raw_output.empty()) {
+        std::cerr << "❌ 推理失败" << std::endl;
+        return false;
+    }
+    double inference_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start_time).count();
+    std::cout << "⚡ 推理时间: " << std::fixed << std::setprecision(4) << inference_ms << " 毫秒" << std::endl;
+
+    std::cout << "📤 原始输出: [";
+    for (size_t i = 0; i < raw_output.size(); ++i) {
+        std::cout << std::fixed << std::setprecision(4) << raw_output[i];
+        if (i < raw_output.size() - 1) std::cout << ", ";
+    }
+    std::cout << "]" << std::endl;
+
+    std::vector<float> probabilities = TritonClient::Softmax(raw_output);
+    auto max_it = std::max_element(probabilities.begin(), probabilities.end());
+    size_t predicted_class = std::distance(probabilities.begin(), max_it);
+    std::string predicted_label = predicted_class < labels.size() ?
+        labels[predicted_class] : "Class_" + std::to_string(predicted_class);
+
+    std::cout << "\n🎯 预测结果:" << std::endl;
+    std::cout << "预测类别: " << predicted_label << std::endl;
+    std::cout << "置信度: " << std::fixed << std::setprecision(4) << *max_it << std::endl;
+    std::cout << "概率分布: ";
+    const size_t shown = std::min(probabilities.size(), labels.size());
+    for (size_t i = 0; i < shown; ++i) {
+        std::cout << labels[i] << "=" << std::fixed << std::setprecision(4) << probabilities[i];
+        if (i + 1 < shown) std::cout << ", ";
+    }
+    std::cout << std::endl;
+    return true;
+}
+
+namespace {
+
+class TritonBackend : public InferBackend {
+public:
+    explicit TritonBackend(const InferBackendConfig& config)
+        : model_name_(config.model_name),
+          client_(config.url.empty() ? DefaultTransportUrl(config.transport) : config.url,
+                  config.verbose, config.transport) {}
+
+    BackendKind Kind() const override { return BackendKind::kTriton; }
+
+    bool IsReady() override {
+        if (!client_.CheckServerHealth()) {
+            return false;
+        }
+        if (!client_.IsModelReady(model_name_)) {
+            std::cerr << "❌ 模型未就绪: " << model_name_ << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool InferBatch(const float* input, size_t batch_size, std::vector<float>* output) override {
+        return client_.InferBatch(model_name_, input, batch_size, output);
+    }
+
+    // 沿用 TritonClient 的输出, 包括服务端返回的原始张量信息
+    bool PredictWithLabels(const std::vector<float>& input_data,
+                           const std::vector<std::string>& labels) override {
+        return client_.PredictWithLabels(model_name_, input_data, labels);
+    }
+
+    TritonClient* triton_client() override { return &client_; }
+
+private:
+    std::string model_name_;
+    TritonClient client_;
+};
+
+#ifdef ENABLE_ONNXRUNTIME
+
+// 进程内只需要一个 Ort::Env, 其中的全局日志器由所有会话共享
+Ort::Env& SharedOrtEnv() {
+    static Ort::Env env(ORT_LOGGING_LEVEL_WARNING, "track_classify");
+    return env;
+}
+
+class OnnxRuntimeBackend : public InferBackend {
+public:
+    explicit OnnxRuntimeBackend(const InferBackendConfig& config) : config_(config) {}
+
+    bool Load() {
+        try {
+            Ort::SessionOptions options;
+            // 单个调用者顺序执行, 并行只发生在算子内部
+            options.SetExecutionMode(ExecutionMode::ORT_SEQUENTIAL);
+            options.SetInterOpNumThreads(1);
+            if (config_.intra_op_threads > 0) {
+                options.SetIntraOpNumThreads(config_.intra_op_threads);
+            }
+            options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+            session_.reset(new Ort::Session(SharedOrtEnv(), config_.onnx_path.c_str(), options));
+
+            Ort::AllocatorWithDefaultOptions allocator;
+            input_name_ = session_->GetInputNameAllocated(0, allocator).get();
+            output_name_ = session_->GetOutputNameAllocated(0, allocator).get();
+            std::vector<int64_t> output_shape =
+                session_->GetOutputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+            num_classes_ = (output_shape.size() == 2 && output_shape[1] > 0) ?
+                static_cast<size_t>(output_shape[1]) : config_.num_classes;
+
+            // 输入输出缓冲按最大批大小分配一次, 每个批大小一个 IoBinding, 张量直接引用这两块缓冲
+            const size_t window_size = 20 * 14;
+            const size_t max_batch = std::max<size_t>(config_.max_batch, 1);
+            input_buffer_.assign(max_batch * window_size, 0.0f);
+            output_buffer_.assign(max_batch * num_classes_, 0.0f);
+            Ort::MemoryInfo memory = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+            bindings_.clear();
+            for (size_t batch = 1; batch <= max_batch; ++batch) {
+                std::unique_ptr<Binding> binding(new Binding(*session_));
+                const int64_t input_shape[] = {static_cast<int64_t>(batch), 20, 14};
+                const int64_t output_shape2[] = {static_cast<int64_t>(batch),
+                                                 static_cast<int64_t>(num_classes_)};
+                binding->input = Ort::Value::CreateTensor<float>(
+                    memory, input_buffer_.data(), batch * window_size, input_shape, 3);
+                binding->output = Ort::Value::CreateTensor<float>(
+                    memory, output_buffer_.data(), batch * num_classes_, output_shape2, 2);
+                binding->io.BindInput(input_name_.c_str(), binding->input);
+                binding->io.BindOutput(output_name_.c_str(), binding->output);
+                bindings_.push_back(std::move(binding));
+            }
+        } catch (const Ort::Exception& e) {
+            std::cerr << "❌ 加载 ONNX 模型失败 (" << config_.onnx_path << "): " << e.what() << std::endl;
+            session_.reset();
+            return false;
+        }
+
+        std::cout << "✅ 已加载 ONNX 模型 " << config_.onnx_path << " (输入 " << input_name_
+                  << ", 输出 " << output_name_ << ", " << num_classes_ << " 类, 算子内线程 "
+                  << (config_.intra_op_threads > 0 ? std::to_string(config_.intra_op_threads) : "默认")
+                  << ")" << std::endl;
+        return true;
+    }
+
+    BackendKind Kind() const override { return BackendKind::kOnnxRuntime; }
+
+    bool IsReady() override { return session_ != nullptr; }
+
+    bool InferBatch(const float* input, size_t batch_size, std::vector<float>* output) override {
+        if (!session_ || batch_size == 0) return false;
+
+        const size_t window_size = 20 * 14;
+        output->resize(batch_size * num_classes_);
+        try {
+            for (size_t offset = 0; offset < batch_size; offset += bindings_.size()) {
+                size_t count = std::min(bindings_.size(), batch_size - offset);
+                std::memcpy(input_buffer_.data(), input + offset * window_size,
+                            count * window_size * sizeof(float));
+                session_->Run(run_options_, bindings_[count - 1]->io);
+                std::memcpy(output->data() + offset * num_classes_, output_buffer_.data(),
+                            count * num_classes_ * sizeof(float));
+            }
+        } catch (const Ort::Exception& e) {
+            std::cerr << "❌ 推理失败: " << e.what() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+private:
+    struct Binding {
+        explicit Binding(Ort::Session& session) : io(session) {}
+        Ort::Value input{nullptr};
+        Ort::Value output{nullptr};
+        Ort::IoBinding io;
+    };
+
+    InferBackendConfig config_;
+    std::unique_ptr<Ort::Session> session_;
+    Ort::RunOptions run_options_;
+    std::string input_name_;
+    std::string output_name_;
+    size_t num_classes_ = 0;
+    std::vector<float> input_buffer_;
+    std::vector<float> output_buffer_;
+    std::vector<std::unique_ptr<Binding>> bindings_;    // [批大小 - 1]
+};
+
+#endif  // ENABLE_ONNXRUNTIME
+
+}  // namespace
+
+std::unique_ptr<InferBackend> InferBackend::Create(const InferBackendConfig& config) {
+    if (config.kind == BackendKind::kTriton) {
+        return std::unique_ptr<InferBackend>(new TritonBackend(config));
+    }
+
+#ifdef ENABLE_ONNXRUNTIME
+    std::unique_ptr<OnnxRuntimeBackend> backend(new OnnxRuntimeBackend(config));
+    if (!backend->Load()) {
+        return nullptr;
+    }
+    return std::unique_ptr<InferBackend>(backend.release());
+#else
+    std::cerr << "❌ 未启用 ONNX Runtime 后端, 以 -DENABLE_ONNXRUNTIME=ON 重新构建" << std::endl;
+    return nullptr;
+#endif
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+// 推理后端抽象: 远程 Triton 服务, 或进程内 ONNX Runtime(CPU)
+// 没有 Triton 服务器的边缘站点直接在进程内加载 Times_Classify.onnx, 调用方只按配置切换
+//
+// ONNX Runtime 后端需要以 -DENABLE_ONNXRUNTIME=ON 构建; 输入输出缓冲和各批大小的 IoBinding
+// 在创建时一次分配好, 推理时只拷贝输入窗口, 不再为每个请求分配张量
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "infer_transport.h"
+
+class TritonClient;
+
+enum class BackendKind {
+    kTriton,
+    kOnnxRuntime,
+};
+
+// 解析 "triton" / "onnxruntime", 无法识别时返回 false
+bool ParseBackendKind(const std::string& name, BackendKind* kind);
+const char* BackendKindName(BackendKind kind);
+
+struct InferBackendConfig {
+    BackendKind kind = BackendKind::kTriton;
+    std::string model_name = "Times_Classify";
+    // 远程 Triton
+    std::string url;                    // 为空时使用协议的默认地址
+    TransportKind transport = TransportKind::kHttp;
+    bool verbose = false;
+    // 进程内 ONNX Runtime
+    std::string onnx_path = "model_repository/Times_Classify/1/Times_Classify.onnx";
+    int intra_op_threads = 0;           // 算子内并行线程数, 0 表示由 ONNX Runtime 按物理核数决定
+    size_t max_batch = 32;              // 预分配的最大批大小, 更大的批按此切分
+    size_t num_classes = 2;             // 模型输出类别维为动态时使用
+};
+
+class InferBackend {
+public:
+    virtual ~InferBackend() = default;
+
+    virtual BackendKind Kind() const = 0;
+
+    // Triton: 服务存活且模型就绪; ONNX Runtime: 会话已加载
+    virtual bool IsReady() = 0;
+
+    // 批量推理, 不打印日志, 与 InferFn 约定相同:
+    // input 为行主序 [batch_size, 20, 14], output 写入 [batch_size, 类别数]
+    // 同一后端对象同一时刻只允许一个调用者
+    virtual bool InferBatch(const float* input, size_t batch_size, std::vector<float>* output) = 0;
+
+    // 单个窗口推理并打印概率分布和预测类别
+    virtual bool PredictWithLabels(const std::vector<float>& input_data,
+                                   const std::vector<std::string>& labels = {"bird", "uav"});
+
+    // 远程后端的底层客户端, 供健康检查、模型信息、热启动等 Triton 专有功能使用; 进程内后端返回空指针
+    virtual TritonClient* triton_client() { return nullptr; }
+
+    // 创建后端, 失败时打印原因并返回空指针
+    static std::unique_ptr<InferBackend> Create(const InferBackendConfig& config);
+};
@@ -0,0 +1,367 @@
+#include "infer_transport.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef TRITON_ENABLE_GRPC
+#include <google/protobuf/util/json_util.h>
+
+#include "grpc_client.h"
+#endif
+
+bool ParseTransportKind(const std::string& name, TransportKind* kind) {
+    if (name == "http") {
+        *kind = TransportKind::kHttp;
+    } else if (name == "grpc") {
+        *kind = TransportKind::kGrpc;
+    } else if (name == "grpc-stream") {
+        *kind = TransportKind::kGrpcStream;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* TransportKindName(TransportKind kind) {
+    switch (kind) {
+        case TransportKind::kHttp: return "http";
+        case TransportKind::kGrpc: return "grpc";
+        case TransportKind::kGrpcStream: return "grpc-stream";
+    }
+    return "unknown";
+}
+
+const char* DefaultTransportUrl(TransportKind kind) {
+    return kind == TransportKind::kHttp ? "localhost:8000" : "localhost:8001";
+}
+
+namespace {
+
+class HttpTransport : public InferTransport {
+public:
+    explicit HttpTransport(std::unique_ptr<tc::InferenceServerHttpClient> client)
+        : client_(std::move(client)) {}
+
+    TransportKind Kind() const override { return TransportKind::kHttp; }
+
+    tc::Error IsServerLive(bool* live) override {
+        return client_->IsServerLive(live);
+    }
+
+    tc::Error IsModelReady(bool* ready, const std::string& model_name,
+                           const std::string& model_version) override {
+        return client_->IsModelReady(ready, model_name, model_version);
+    }
+
+    tc::Error ModelMetadata(std::string* metadata, const std::string& model_name,
+                            const std::string& model_version) override {
+        return client_->ModelMetadata(metadata, model_name, model_version);
+    }
+
+    tc::Error ModelConfig(std::string* config, const std::string& model_name,
+                          const std::string& model_version) override {
+        return client_->ModelConfig(config, model_name, model_version);
+    }
+
+    tc::Error ModelRepositoryIndex(std::string* index) override {
+        return client_->ModelRepositoryIndex(index);
+    }
+
+    tc::Error ModelStatistics(std::string* stats, const std::string& model_name,
+                              const std::string& model_version) override {
+        return client_->ModelInferenceStatistics(stats, model_name, model_version);
+    }
+
+    tc::Error RegisterSystemSharedMemory(const std::string& name, const std::string& key,
+                                         size_t byte_size) override {
+        return client_->RegisterSystemSharedMemory(name, key, byte_size);
+    }
+
+    tc::Error UnregisterSystemSharedMemory(const std::string& name) override {
+        return client_->UnregisterSystemSharedMemory(name);
+    }
+
+    tc::Error Infer(tc::InferResult** result, const tc::InferOptions& options,
+                    const std::vector<tc::InferInput*>& inputs,
+                    const std::vector<const tc::InferRequestedOutput*>& outputs) override {
+        return client_->Infer(result, options, inputs, outputs);
+    }
+
+    tc::Error AsyncInfer(OnCompleteFn callback, const tc::InferOptions& options,
+                         const std::vector<tc::InferInput*>& inputs,
+                         const std::vector<const tc::InferRequestedOutput*>& outputs) override {
+        return client_->AsyncInfer(callback, options, inputs, outputs);
+    }
+
+private:
+    std::unique_ptr<tc::InferenceServerHttpClient> client_;
+};
+
+#ifdef TRITON_ENABLE_GRPC
+
+// 与 HTTP 接口保持一致, 输出 snake_case 字段名的 JSON
+tc::Error ProtoToJson(const google::protobuf::Message& message, std::string* json) {
+    google::protobuf::util::JsonPrintOptions options;
+    options.preserve_proto_field_names = true;
+    auto status = google::protobuf::util::MessageToJsonString(message, json, options);
+    if (!status.ok()) {
+        return tc::Error("protobuf 转 JSON 失败: " + status.ToString());
+    }
+    return tc::Error::Success;
+}
+
+class GrpcTransport : public InferTransport {
+public:
+    explicit GrpcTransport(std::unique_ptr<tc::InferenceServerGrpcClient> client)
+        : client_(std::move(client)) {}
+
+    TransportKind Kind() const override { return TransportKind::kGrpc; }
+
+    tc::Error IsServerLive(bool* live) override {
+        return client_->IsServerLive(live);
+    }
+
+    tc::Error IsModelReady(bool* ready, const std::string& model_name,
+                           const std::string& model_version) override {
+        return client_->IsModelReady(ready, model_name, model_version);
+    }
+
+    tc::Error ModelMetadata(std::string* metadata, const std::string& model_name,
+                            const std::string& model_version) override {
+        inference::ModelMetadataResponse response;
+        tc::Error err = client_->ModelMetadata(&response, model_name, model_version);
+        return err.IsOk() ? ProtoToJson(response, metadata) : err;
+    }
+
+    tc::Error ModelConfig(std::string* config, const std::string& model_name,
+                          const std::string& model_version) override {
+        inference::ModelConfigResponse response;
+        tc::Error err = client_->ModelConfig(&response, model_name, model_version);
+        // HTTP 直接返回配置本身, 这里同样去掉外层的 config 字段
+        return err.IsOk() ? ProtoToJson(response.config(), config) : err;
+    }
+
+    tc::Error ModelRepositoryIndex(std::string* index) override {
+        inference::RepositoryIndexResponse response;
+        tc::Error err = client_->ModelRepositoryIndex(&response);
+        return err.IsOk() ? ProtoToJson(response, index) : err;
+    }
+
+    tc::Error ModelStatistics(std::string* stats, const std::string& model_name,
+                              const std::string& model_version) override {
+        inference::ModelStatisticsResponse response;
+        tc::Error err = client_->ModelInferenceStatistics(&response, model_name, model_version);
+        return err.IsOk() ? ProtoToJson(response, stats) : err;
+    }
+
+    tc::Error RegisterSystemSharedMemory(const std::string& name, const std::string& key,
+                                         size_t byte_size) override {
+        return client_->RegisterSystemSharedMemory(name, key, byte_size);
+    }
+
+    tc::Error UnregisterSystemSharedMemory(const std::string& name) override {
+        return client_->UnregisterSystemSharedMemory(name);
+    }
+
+    tc::Error Infer(tc::InferResult** result, const tc::InferOptions& options,
+                    const std::vector<tc::InferInput*>& inputs,
+                    const std::vector<const tc::InferRequestedOutput*>& outputs) override {
+        return client_->Infer(result, options, inputs, outputs);
+    }
+
+    tc::Error AsyncInfer(OnCompleteFn callback, const tc::InferOptions& options,
+                         const std::vector<tc::InferInput*>& inputs,
+                         const std::vector<const tc::InferRequestedOutput*>& outputs) override {
+        return client_->AsyncInfer(callback, options, inputs, outputs);
+    }
+
+protected:
+    std::unique_ptr<tc::InferenceServerGrpcClient> client_;
+};
+
+// 未指定客户端超时时, 流式同步推理等待响应的上限
+constexpr uint64_t kDefaultStreamTimeoutUs = 10 * 1000 * 1000;
+
+// 只携带错误状态的推理结果, 流出错无法对应到具体请求时交给各在途请求的回调
+class StreamErrorResult : public tc::InferResult {
+public:
+    explicit StreamErrorResult(const tc::Error& error) : error_(error) {}
+
+    tc::Error ModelName(std::string*) const override { return error_; }
+    tc::Error ModelVersion(std::string*) const override { return error_; }
+    tc::Error Id(std::string*) const override { return error_; }
+    tc::Error Shape(const std::string&, std::vector<int64_t>*) const override { return error_; }
+    tc::Error Datatype(const std::string&, std::string*) const override { return error_; }
+    tc::Error RawData(const std::string&, const uint8_t**, size_t*) const override { return error_; }
+    tc::Error IsFinalResponse(bool* is_final_response) const override {
+        *is_final_response = true;
+        return tc::Error::Success;
+    }
+    tc::Error IsNullResponse(bool* is_null_response) const override {
+        *is_null_response = false;
+        return tc::Error::Success;
+    }
+    tc::Error StringData(const std::string&, std::vector<std::string>*) const override {
+        return error_;
+    }
+    std::string DebugString() const override { return error_.Message(); }
+    tc::Error RequestStatus() const override { return error_; }
+
+private:
+    tc::Error error_;
+};
+
+// 双向流: 所有推理请求写入同一条流, 响应按 request_id 分发给各自的回调;
+// 元数据等非推理接口仍走普通 gRPC 调用
+class GrpcStreamTransport : public GrpcTransport {
+public:
+    explicit GrpcStreamTransport(std::unique_ptr<tc::InferenceServerGrpcClient> client)
+        : GrpcTransport(std::move(client)) {}
+
+    ~GrpcStreamTransport() override {
+        // 等待流上的响应全部返回, 之后不会再有回调访问本对象; 仍未返回的请求以错误结束
+        client_->StopStream();
+        FailPending(tc::Error("推理流已关闭"));
+    }
+
+    tc::Error Start() {
+        return client_->StartStream(
+            [this](tc::InferResult* result) { OnStreamResponse(result); }, false);
+    }
+
+    TransportKind Kind() const override { return TransportKind::kGrpcStream; }
+
+    tc::Error Infer(tc::InferResult** result, const tc::InferOptions& options,
+                    const std::vector<tc::InferInput*>& inputs,
+                    const std::vector<const tc::InferRequestedOutput*>& outputs) override {
+        auto promise = std::make_shared<std::promise<tc::InferResult*>>();
+        std::future<tc::InferResult*> future = promise->get_future();
+        std::string request_id;
+        tc::Error err = Send([promise](tc::InferResult* r) { promise->set_value(r); },
+                             options, inputs, outputs, &request_id);
+        if (!err.IsOk()) {
+            return err;
+        }
+
+        // 流中断且没有错误响应时不会有回调, 同步调用总是限时等待
+        const uint64_t timeout_us =
+            options.client_timeout_ > 0 ? options.client_timeout_ : kDefaultStreamTimeoutUs;
+        if (future.wait_for(std::chrono::microseconds(timeout_us)) != std::future_status::ready) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // 响应可能恰好在超时后到达, 已被取走则仍按成功处理
+            if (pending_.erase(request_id) > 0) {
+                return tc::Error("流式推理超时");
+            }
+        }
+        *result = future.get();
+        return tc::Error::Success;
+    }
+
+    tc::Error AsyncInfer(OnCompleteFn callback, const tc::InferOptions& options,
+                         const std::vector<tc::InferInput*>& inputs,
+                         const std::vector<const tc::InferRequestedOutput*>& outputs) override {
+        std::string request_id;
+        return Send(std::move(callback), options, inputs, outputs, &request_id);
+    }
+
+private:
+    tc::Error Send(OnCompleteFn callback, const tc::InferOptions& options,
+                   const std::vector<tc::InferInput*>& inputs,
+                   const std::vector<const tc::InferRequestedOutput*>& outputs,
+                   std::string* request_id) {
+        tc::InferOptions stream_options = options;
+        stream_options.request_id_ = std::to_string(next_request_id_++);
+        *request_id = stream_options.request_id_;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.emplace(*request_id, std::move(callback));
+        }
+        tc::Error err = client_->AsyncStreamInfer(stream_options, inputs, outputs);
+        if (!err.IsOk()) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.erase(*request_id);
+        }
+        return err;
+    }
+
+    void OnStreamResponse(tc::InferResult* result) {
+        std::string request_id;
+        OnCompleteFn callback;
+        const bool has_id = result->Id(&request_id).IsOk() && !request_id.empty();
+        if (has_id) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = pending_.find(request_id);
+            if (it != pending_.end()) {
+                callback = std::move(it->second);
+                pending_.erase(it);
+            }
+        }
+        if (callback) {
+            callback(result);
+            return;
+        }
+        tc::Error status = result->RequestStatus();
+        delete result;
+        if (!has_id) {
+            // 流级错误(连接断开、服务端拒绝流等)不带 request_id, 无法判断属于哪个请求,
+            // 全部在途请求以该错误结束, 避免调用方一直等待
+            FailPending(status.IsOk() ? tc::Error("流式响应缺少 request_id") : status);
+        }
+        // 带 request_id 但无人等待的是已超时放弃的请求, 直接丢弃
+    }
+
+    void FailPending(const tc::Error& error) {
+        std::unordered_map<std::string, OnCompleteFn> pending;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending.swap(pending_);
+        }
+        for (auto& entry : pending) {
+            entry.second(new StreamErrorResult(error));
+        }
+    }
+
+    std::atomic<uint64_t> next_request_id_{0};
+    std::mutex mutex_;
+    std::unordered_map<std::string, OnCompleteFn> pending_;
+};
+
+#endif  // TRITON_ENABLE_GRPC
+
+}  // namespace
+
+std::unique_ptr<InferTransport> InferTransport::Create(TransportKind kind, const std::string& url,
+                                                       bool verbose, tc::Error* err) {
+    if (kind == TransportKind::kHttp) {
+        std::unique_ptr<tc::InferenceServerHttpClient> client;
+        *err = tc::InferenceServerHttpClient::Create(&client, url, verbose);
+        if (!err->IsOk()) {
+            return nullptr;
+        }
+        return std::unique_ptr<InferTransport>(new HttpTransport(std::move(client)));
+    }
+
+#ifdef TRITON_ENABLE_GRPC
+    std::unique_ptr<tc::InferenceServerGrpcClient> client;
+    *err = tc::InferenceServerGrpcClient::Create(&client, url, verbose);
+    if (!err->IsOk()) {
+        return nullptr;
+    }
+    if (kind == TransportKind::kGrpc) {
+        return std::unique_ptr<InferTransport>(new GrpcTransport(std::move(client)));
+    }
+    std::unique_ptr<GrpcStreamTransport> stream(new GrpcStreamTransport(std::move(client)));
+    *err = stream->Start();
+    if (!err->IsOk()) {
+        return nullptr;
+    }
+    return std::unique_ptr<InferTransport>(stream.release());
+#else
+    *err = tc::Error(std::string("未启用 gRPC 支持, 无法使用 ") + TransportKindName(kind) +
+                     " (以 -DTRITON_ENABLE_GRPC=ON 重新构建)");
+    return nullptr;
+#endif
+}
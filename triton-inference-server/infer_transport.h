@@ -0,0 +1,63 @@
+#pragma once
+
+// 推理传输层抽象: HTTP、gRPC 以及 gRPC 双向流
+// gRPC 流模式下所有请求复用一条长连接的 HTTP/2 流, 通过 request_id 匹配响应
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "http_client.h"
+
+namespace tc = triton::client;
+
+enum class TransportKind {
+    kHttp,
+    kGrpc,
+    kGrpcStream,
+};
+
+// 解析 "http" / "grpc" / "grpc-stream", 无法识别时返回 false
+bool ParseTransportKind(const std::string& name, TransportKind* kind);
+const char* TransportKindName(TransportKind kind);
+// 各协议的默认服务地址
+const char* DefaultTransportUrl(TransportKind kind);
+
+class InferTransport {
+public:
+    using OnCompleteFn = tc::InferenceServerClient::OnCompleteFn;
+
+    virtual ~InferTransport() = default;
+
+    virtual TransportKind Kind() const = 0;
+
+    virtual tc::Error IsServerLive(bool* live) = 0;
+    virtual tc::Error IsModelReady(bool* ready, const std::string& model_name,
+                                   const std::string& model_version = "") = 0;
+    // 以下四个接口统一返回 JSON 文本, gRPC 的 protobuf 响应保留原字段名转换
+    virtual tc::Error ModelMetadata(std::string* metadata, const std::string& model_name,
+                                    const std::string& model_version = "") = 0;
+    virtual tc::Error ModelConfig(std::string* config, const std::string& model_name,
+                                  const std::string& model_version = "") = 0;
+    virtual tc::Error ModelRepositoryIndex(std::string* index) = 0;
+    // 服务端累计的推理统计(排队/计算耗时等)
+    virtual tc::Error ModelStatistics(std::string* stats, const std::string& model_name,
+                                      const std::string& model_version = "") = 0;
+
+    // 系统共享内存扩展, 仅在客户端与服务端同机时可用
+    virtual tc::Error RegisterSystemSharedMemory(const std::string& name, const std::string& key,
+                                                 size_t byte_size) = 0;
+    virtual tc::Error UnregisterSystemSharedMemory(const std::string& name) = 0;
+
+    virtual tc::Error Infer(tc::InferResult** result, const tc::InferOptions& options,
+                            const std::vector<tc::InferInput*>& inputs,
+                            const std::vector<const tc::InferRequestedOutput*>& outputs) = 0;
+    // 回调在传输层的工作线程中执行, 负责释放 result
+    virtual tc::Error AsyncInfer(OnCompleteFn callback, const tc::InferOptions& options,
+                                 const std::vector<tc::InferInput*>& inputs,
+                                 const std::vector<const tc::InferRequestedOutput*>& outputs) = 0;
+
+    // 创建传输层, 失败时返回空指针并通过 err 返回原因
+    static std::unique_ptr<InferTransport> Create(TransportKind kind, const std::string& url,
+                                                  bool verbose, tc::Error* err);
+};
@@ -0,0 +1,238 @@
+#include "model_router.h"
+
+#include <json/json.h>
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "track_window.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 版本号按数值比较, 无法解析时视为 -1
+int64_t VersionNumber(const std::string& version) {
+    try {
+        return std::stoll(version);
+    } catch (const std::exception&) {
+        return -1;
+    }
+}
+
+std::string RouteName(const std::string& model, const std::string& version) {
+    return model + ":" + version;
+}
+
+}  // namespace
+
+bool ParseRepositoryIndex(const std::string& json, std::vector<ModelIndexEntry>* entries) {
+    Json::CharReaderBuilder builder;
+    std::istringstream stream(json);
+    Json::Value root;
+    std::string errors;
+    if (!Json::parseFromStream(builder, stream, &root, &errors)) {
+        std::cerr << "❌ 解析模型仓库索引失败: " << errors << std::endl;
+        return false;
+    }
+
+    // HTTP 返回数组, gRPC 转换后的 JSON 为 {"models": [...]}
+    const Json::Value& models = root.isArray() ? root : root["models"];
+    entries->clear();
+    for (const Json::Value& model : models) {
+        ModelIndexEntry entry;
+        entry.name = model["name"].asString();
+        entry.version = model["version"].asString();
+        entry.state = model["state"].asString();
+        entries->push_back(entry);
+    }
+    return true;
+}
+
+ModelRouter::ModelRouter(TritonClient* data_client, const std::string& url,
+                         TransportKind transport, const ModelRouterConfig& config)
+    : data_client_(data_client),
+      config_(config),
+      control_(new TritonClient(url, false, transport)) {}
+
+ModelRouter::~ModelRouter() {
+    Stop();
+}
+
+bool ModelRouter::Start() {
+    Poll(nullptr);
+    if (!ActiveRoute()) {
+        std::cerr << "❌ 没有就绪的模型可用" << std::endl;
+        return false;
+    }
+    thread_ = std::thread(&ModelRouter::Run, this);
+    return true;
+}
+
+void ModelRouter::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(stop_mutex_);
+        stop_ = true;
+    }
+    stop_cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void ModelRouter::Run() {
+    std::unique_lock<std::mutex> lock(stop_mutex_);
+    while (!stop_cv_.wait_for(lock, std::chrono::milliseconds(config_.poll_interval_ms),
+                              [this] { return stop_; })) {
+        lock.unlock();
+        Poll(nullptr);
+        lock.lock();
+    }
+}
+
+std::shared_ptr<ModelRouter::Route> ModelRouter::ActiveRoute() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return active_;
+}
+
+bool ModelRouter::Probe(const Route& route) {
+    // 用全零窗口探测, 同时让新版本在接收真实流量前完成首批请求的初始化
+    std::vector<float> input(kWindowSteps * kFeatureDim, 0.0f);
+    std::vector<float> output;
+    for (int i = 0; i < config_.probe_rounds; ++i) {
+        if (!control_->InferBatch(route.model, input.data(), 1, &output, route.version)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ModelRouter::IsRouteReady(const Route& route) {
+    std::lock_guard<std::mutex> poll_lock(poll_mutex_);
+    return control_->IsModelReady(route.model, route.version);
+}
+
+void ModelRouter::Poll(const std::shared_ptr<Route>& failed) {
+    std::lock_guard<std::mutex> poll_lock(poll_mutex_);
+
+    std::string index_json;
+    std::vector<ModelIndexEntry> entries;
+    if (!control_->FetchRepositoryIndex(&index_json) ||
+        !ParseRepositoryIndex(index_json, &entries)) {
+        return;
+    }
+
+    // 按优先级选出第一个有就绪版本的模型, 取其最高的就绪版本
+    std::string model;
+    std::string version;
+    for (const std::string& name : config_.models) {
+        int64_t best = -1;
+        for (const ModelIndexEntry& entry : entries) {
+            if (entry.name != name || entry.state != "READY") {
+                continue;
+            }
+            if (failed && failed->model == entry.name && failed->version == entry.version) {
+                continue;
+            }
+            int64_t v = VersionNumber(entry.version);
+            if (v > best) {
+                best = v;
+                version = entry.version;
+            }
+        }
+        if (best >= 0 && control_->IsModelReady(name, version)) {
+            model = name;
+            break;
+        }
+    }
+
+    std::shared_ptr<Route> current = ActiveRoute();
+    if (!model.empty() && !(current && current->model == model && current->version == version)) {
+        auto route = std::make_shared<Route>();
+        route->model = model;
+        route->version = version;
+        // 请求失败时尽快转移, 不做探测; 主动切换则要求新目标先通过探测
+        if (failed || Probe(*route)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (current) {
+                draining_.push_back(current);
+            }
+            active_ = route;
+            if (failed) {
+                stats_.failovers++;
+            } else {
+                stats_.switches++;
+            }
+            std::cout << "🔄 模型路由: " << (current ? RouteName(current->model, current->version) : "-")
+                      << " -> " << RouteName(model, version) << (failed ? " (故障转移)" : "") << std::endl;
+        }
+    }
+
+    // 旧目标上的在途请求全部完成后释放
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = draining_.begin(); it != draining_.end();) {
+        if ((*it)->inflight.load() == 0) {
+            stats_.drained++;
+            it = draining_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool ModelRouter::Infer(const float* input, size_t batch_size, std::vector<float>* output) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.requests++;
+    }
+
+    const auto deadline = Clock::now() + std::chrono::milliseconds(config_.failover_wait_ms);
+    bool retried = false;
+    while (true) {
+        std::shared_ptr<Route> route = ActiveRoute();
+        if (route) {
+            route->inflight++;
+            bool ok = data_client_->InferBatch(route->model, input, batch_size, output, route->version);
+            route->inflight--;
+            if (ok) {
+                if (retried) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stats_.retries++;
+                }
+                return true;
+            }
+            // 固定的版本仍就绪说明不是重载, 重试也不会成功, 不占用推理线程等待
+            if (IsRouteReady(*route)) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stats_.errors++;
+                return false;
+            }
+        }
+        if (Clock::now() >= deadline) {
+            break;
+        }
+
+        // 当前目标已不可用(卸载或重载中): 立即刷新状态转到其他就绪目标, 没有时稍后再试
+        retried = true;
+        std::shared_ptr<Route> before = ActiveRoute();
+        if (route && route == before) {
+            Poll(route);
+        }
+        if (ActiveRoute() == before) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(config_.retry_backoff_ms));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.failures++;
+    return false;
+}
+
+ModelRouterStats ModelRouter::Stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ModelRouterStats stats = stats_;
+    stats.active = active_ ? RouteName(active_->model, active_->version) : "-";
+    return stats;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+// 模型重载感知路由: 服务器以 poll 模式运行时, 向模型仓库放入新引擎会触发后台加载/卸载
+// 路由器在后台线程中轮询仓库索引和就绪状态, 每个请求固定到一个已就绪的 (模型, 版本);
+// 新版本就绪并通过探测后才切换, 旧版本上的在途请求自然排空;
+// 请求失败且就绪探测确认所固定的版本已不可用时, 立即转到下一个就绪的版本或变体重试,
+// 调用方看不到重载过程; 版本仍就绪时按普通错误(输入有误、超时等)直接返回
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "triton_client.h"
+
+struct ModelRouterConfig {
+    // 按优先级排列的模型/变体, 如 {"Times_Classify_TRT_DYNAMIC", "Times_Classify"}
+    std::vector<std::string> models;
+    int64_t poll_interval_ms = 1000;    // 应小于服务器的 polling-interval (config/triton.conf 中为 5s)
+    int64_t failover_wait_ms = 3000;    // 没有任何就绪目标时请求最多等待的时间
+    int64_t retry_backoff_ms = 50;
+    int probe_rounds = 2;               // 切换前在新目标上发送的探测请求数
+};
+
+struct ModelRouterStats {
+    uint64_t requests = 0;
+    uint64_t switches = 0;              // 主动切换到新版本/更高优先级变体的次数
+    uint64_t failovers = 0;             // 请求失败触发的切换次数
+    uint64_t retries = 0;               // 重试后成功的请求数
+    uint64_t failures = 0;              // 重试耗尽仍失败的请求数
+    uint64_t errors = 0;                // 目标仍就绪、不做故障转移直接返回的失败数
+    uint64_t drained = 0;               // 切换后在途请求已全部完成的旧目标数
+    std::string active;                 // 当前目标, 形如 model:version
+};
+
+// 仓库索引中的一项, HTTP 与 gRPC 的输出均可解析
+struct ModelIndexEntry {
+    std::string name;
+    std::string version;
+    std::string state;                  // READY / LOADING / UNLOADING / UNAVAILABLE
+};
+bool ParseRepositoryIndex(const std::string& json, std::vector<ModelIndexEntry>* entries);
+
+class ModelRouter {
+public:
+    // data_client 承载推理请求, 仅由调用 Infer 的线程使用;
+    // 路由器另建一条控制连接用于轮询与探测, 不与推理请求争用
+    ModelRouter(TritonClient* data_client, const std::string& url, TransportKind transport,
+                const ModelRouterConfig& config);
+    ~ModelRouter();
+
+    ModelRouter(const ModelRouter&) = delete;
+    ModelRouter& operator=(const ModelRouter&) = delete;
+
+    // 同步完成首次轮询后启动后台线程, 没有任何就绪目标时返回 false
+    bool Start();
+    void Stop();
+
+    // 与 InferFn 签名一致
+    bool Infer(const float* input, size_t batch_size, std::vector<float>* output);
+
+    ModelRouterStats Stats() const;
+
+private:
+    struct Route {
+        std::string model;
+        std::string version;
+        std::atomic<int> inflight{0};
+    };
+
+    void Run();
+    // 刷新仓库状态并在需要时切换; failed 非空时表示该目标刚刚请求失败, 需立即避开
+    void Poll(const std::shared_ptr<Route>& failed);
+    bool Probe(const Route& route);
+    // 通过控制连接确认目标版本是否仍就绪
+    bool IsRouteReady(const Route& route);
+    std::shared_ptr<Route> ActiveRoute();
+
+    TritonClient* data_client_;
+    ModelRouterConfig config_;
+    std::unique_ptr<TritonClient> control_;
+    std::mutex poll_mutex_;             // 串行化控制连接上的调用
+
+    mutable std::mutex mutex_;          // 保护以下成员
+    std::shared_ptr<Route> active_;
+    std::vector<std::shared_ptr<Route>> draining_;
+    ModelRouterStats stats_;
+
+    std::thread thread_;
+    std::mutex stop_mutex_;
+    std::condition_variable stop_cv_;
+    bool stop_ = false;
+};
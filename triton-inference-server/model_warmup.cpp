@@ -0,0 +1,306 @@
+#include "model_warmup.h"
+
+#include <json/json.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+#include "track_window.h"
+#include "triton_client.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+bool ParseJson(const std::string& text, Json::Value* root) {
+    Json::CharReaderBuilder builder;
+    std::istringstream stream(text);
+    std::string errors;
+    if (!Json::parseFromStream(builder, stream, root, &errors)) {
+        std::cerr << "❌ 解析 JSON 失败: " << errors << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// gRPC 的 protobuf JSON 把 int64 输出为字符串, HTTP 输出为数字
+int64_t JsonInt(const Json::Value& value) {
+    return value.isString() ? std::stoll(value.asString()) : value.asInt64();
+}
+
+std::vector<ModelTensorInfo> ParseTensors(const Json::Value& tensors) {
+    std::vector<ModelTensorInfo> result;
+    for (const Json::Value& tensor : tensors) {
+        ModelTensorInfo info;
+        info.name = tensor["name"].asString();
+        info.datatype = tensor["datatype"].asString();
+        for (const Json::Value& dim : tensor["shape"]) {
+            info.shape.push_back(JsonInt(dim));
+        }
+        result.push_back(info);
+    }
+    return result;
+}
+
+Json::Value TensorsToJson(const std::vector<ModelTensorInfo>& tensors) {
+    Json::Value result(Json::arrayValue);
+    for (const ModelTensorInfo& info : tensors) {
+        Json::Value tensor;
+        tensor["name"] = info.name;
+        tensor["datatype"] = info.datatype;
+        tensor["shape"] = Json::Value(Json::arrayValue);
+        for (int64_t dim : info.shape) {
+            tensor["shape"].append(static_cast<Json::Int64>(dim));
+        }
+        result.append(tensor);
+    }
+    return result;
+}
+
+// 校验模型输入输出与 [N, 20, 14] -> [N, 类别数] 的约定一致
+bool CheckTensorLayout(const ModelInfo& info) {
+    if (info.inputs.size() != 1 || info.outputs.size() != 1) {
+        std::cerr << "❌ 模型 " << info.name << " 应有一个输入和一个输出" << std::endl;
+        return false;
+    }
+    const std::vector<int64_t>& shape = info.inputs[0].shape;
+    if (info.inputs[0].datatype != "FP32" || shape.size() < 2 ||
+        shape[shape.size() - 2] != kWindowSteps || shape.back() != kFeatureDim) {
+        std::cerr << "❌ 模型 " << info.name << " 输入不是 FP32 [N, " << kWindowSteps << ", "
+                  << kFeatureDim << "]" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// 需要预热的批大小: 指定值或 2 的幂, 均不超过模型与调用方的上限
+std::vector<size_t> WarmupBatchSizes(const ModelInfo& info, const WarmStartConfig& config) {
+    if (info.max_batch_size <= 0) {
+        return {1};
+    }
+    const size_t limit = std::min(config.max_batch, static_cast<size_t>(info.max_batch_size));
+    std::vector<size_t> sizes;
+    if (!config.batch_sizes.empty()) {
+        for (size_t n : config.batch_sizes) {
+            if (n >= 1 && n <= limit) {
+                sizes.push_back(n);
+            }
+        }
+    } else {
+        for (size_t n = 1; n < limit; n *= 2) {
+            sizes.push_back(n);
+        }
+        sizes.push_back(limit);
+    }
+    std::sort(sizes.begin(), sizes.end());
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+    return sizes;
+}
+
+bool WarmUpBatch(const WarmupInferFn& infer, size_t batch_size, const std::vector<float>& data,
+                 const WarmStartConfig& config, Clock::time_point start,
+                 WarmupBatchReport* report) {
+    report->batch_size = batch_size;
+    std::vector<double> latencies;
+    std::vector<double> finished_at;
+    std::vector<float> output;
+    int streak = 0;
+    for (int round = 0; round < config.max_rounds; ++round) {
+        auto begin = Clock::now();
+        if (!infer(data.data(), batch_size, &output)) {
+            std::cerr << "❌ 预热请求失败, 批大小 " << batch_size << std::endl;
+            return false;
+        }
+        double latency_ms = ElapsedMs(begin);
+        // 与目前为止的最低延迟比较, 连续 stable_rounds 次都接近最低值才算稳定;
+        // 最低值明显下降说明之前的样本仍处于冷启动阶段, 从本次重新计数
+        if (latencies.empty() ||
+            latency_ms * config.settle_ratio < *std::min_element(latencies.begin(), latencies.end())) {
+            streak = 1;
+        } else {
+            double best = std::min(latency_ms, *std::min_element(latencies.begin(), latencies.end()));
+            streak = latency_ms <= best * config.settle_ratio ? streak + 1 : 0;
+        }
+        latencies.push_back(latency_ms);
+        finished_at.push_back(ElapsedMs(start));
+        if (streak >= config.stable_rounds) {
+            report->stable = true;
+            break;
+        }
+    }
+
+    report->requests = static_cast<int>(latencies.size());
+    report->first_latency_ms = latencies.front();
+    report->steady_latency_ms = *std::min_element(latencies.begin(), latencies.end());
+    for (size_t i = 0; i < latencies.size(); ++i) {
+        if (latencies[i] <= report->steady_latency_ms * config.settle_ratio) {
+            report->good_at_ms = finished_at[i];
+            break;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+bool ParseModelInfo(const std::string& metadata_json, const std::string& config_json,
+                    ModelInfo* info) {
+    Json::Value metadata;
+    Json::Value config;
+    if (!ParseJson(metadata_json, &metadata) || !ParseJson(config_json, &config)) {
+        return false;
+    }
+
+    *info = ModelInfo();
+    info->name = metadata["name"].asString();
+    info->platform = metadata["platform"].asString();
+    // versions 按字符串给出, 取数值最大的版本
+    int64_t latest = -1;
+    for (const Json::Value& version : metadata["versions"]) {
+        int64_t v = JsonInt(version);
+        if (v > latest) {
+            latest = v;
+            info->version = version.asString();
+        }
+    }
+    info->inputs = ParseTensors(metadata["inputs"]);
+    info->outputs = ParseTensors(metadata["outputs"]);
+    info->max_batch_size = static_cast<int>(JsonInt(config["max_batch_size"]));
+    for (const Json::Value& n : config["dynamic_batching"]["preferred_batch_size"]) {
+        info->preferred_batch_sizes.push_back(static_cast<int>(JsonInt(n)));
+    }
+    return !info->name.empty() && !info->inputs.empty() && !info->outputs.empty();
+}
+
+bool LoadModelInfoCache(const std::string& path, ModelInfo* info) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    std::stringstream text;
+    text << in.rdbuf();
+    Json::Value root;
+    if (!ParseJson(text.str(), &root)) {
+        return false;
+    }
+
+    *info = ModelInfo();
+    info->name = root["name"].asString();
+    info->version = root["version"].asString();
+    info->platform = root["platform"].asString();
+    info->max_batch_size = root["max_batch_size"].asInt();
+    info->inputs = ParseTensors(root["inputs"]);
+    info->outputs = ParseTensors(root["outputs"]);
+    for (const Json::Value& n : root["preferred_batch_sizes"]) {
+        info->preferred_batch_sizes.push_back(n.asInt());
+    }
+    return !info->name.empty() && !info->inputs.empty() && !info->outputs.empty();
+}
+
+bool SaveModelInfoCache(const std::string& path, const ModelInfo& info) {
+    Json::Value root;
+    root["name"] = info.name;
+    root["version"] = info.version;
+    root["platform"] = info.platform;
+    root["max_batch_size"] = info.max_batch_size;
+    root["inputs"] = TensorsToJson(info.inputs);
+    root["outputs"] = TensorsToJson(info.outputs);
+    root["preferred_batch_sizes"] = Json::Value(Json::arrayValue);
+    for (int n : info.preferred_batch_sizes) {
+        root["preferred_batch_sizes"].append(n);
+    }
+
+    // 先写临时文件再改名, 多个进程同时启动时不会读到半个文件
+    const std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::trunc);
+        if (!out) {
+            std::cerr << "⚠️  无法写入模型缓存: " << path << std::endl;
+            return false;
+        }
+        Json::StreamWriterBuilder builder;
+        out << Json::writeString(builder, root) << std::endl;
+    }
+    return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+bool ResolveModelInfo(TritonClient* client, const std::string& model_name,
+                      const std::string& cache_path, ModelInfo* info, bool* cache_hit) {
+    const std::string path = cache_path.empty() ? model_name + ".model_cache.json" : cache_path;
+    // 缓存命中时只需一次 IsModelReady 确认缓存中的版本仍然就绪
+    const bool hit = LoadModelInfoCache(path, info) && info->name == model_name &&
+                     client->IsModelReady(model_name, info->version);
+    if (!hit) {
+        std::string metadata;
+        std::string model_config;
+        if (!client->FetchModelJson(model_name, &metadata, &model_config) ||
+            !ParseModelInfo(metadata, model_config, info)) {
+            return false;
+        }
+        SaveModelInfoCache(path, *info);
+    }
+    if (cache_hit) {
+        *cache_hit = hit;
+    }
+    return CheckTensorLayout(*info);
+}
+
+bool WarmStart(TritonClient* client, const std::string& model_name,
+               const WarmStartConfig& config, const WarmupInferFn& infer,
+               ModelInfo* info, WarmStartReport* report) {
+    auto start = Clock::now();
+    *report = WarmStartReport();
+    if (!ResolveModelInfo(client, model_name, config.cache_path, info, &report->cache_hit)) {
+        return false;
+    }
+    report->metadata_ms = ElapsedMs(start);
+    client->SetTensorNames(info->inputs[0].name, info->outputs[0].name);
+
+    std::vector<size_t> batch_sizes = WarmupBatchSizes(*info, config);
+    std::vector<float> data(batch_sizes.back() * kWindowSteps * kFeatureDim);
+    std::mt19937 gen(42);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    for (float& v : data) {
+        v = dist(gen);
+    }
+
+    // 从大到小预热, 大批次先触发后端的显存分配和内核选择
+    for (auto it = batch_sizes.rbegin(); it != batch_sizes.rend(); ++it) {
+        WarmupBatchReport batch;
+        if (!WarmUpBatch(infer, *it, data, config, start, &batch)) {
+            return false;
+        }
+        report->time_to_first_good_ms = std::max(report->time_to_first_good_ms, batch.good_at_ms);
+        report->batches.push_back(batch);
+    }
+    std::reverse(report->batches.begin(), report->batches.end());
+    report->ready_ms = ElapsedMs(start);
+    return true;
+}
+
+void PrintWarmStartReport(const WarmStartReport& report) {
+    std::cout << "\n🔥 热启动: 模型信息" << (report.cache_hit ? "来自缓存" : "来自服务器")
+              << ", 耗时 " << std::fixed << std::setprecision(2) << report.metadata_ms << " ms"
+              << std::endl;
+    std::cout << std::setw(8) << "batch" << std::setw(10) << "requests"
+              << std::setw(12) << "first ms" << std::setw(12) << "steady ms"
+              << std::setw(12) << "good at ms" << std::setw(8) << "stable" << std::endl;
+    for (const WarmupBatchReport& batch : report.batches) {
+        std::cout << std::setw(8) << batch.batch_size << std::setw(10) << batch.requests
+                  << std::setw(12) << batch.first_latency_ms << std::setw(12) << batch.steady_latency_ms
+                  << std::setw(12) << batch.good_at_ms << std::setw(8) << (batch.stable ? "yes" : "no")
+                  << std::endl;
+    }
+    std::cout << "⏱️  首次达到稳态延迟: " << report.time_to_first_good_ms << " ms, 就绪: "
+              << report.ready_ms << " ms" << std::endl;
+}
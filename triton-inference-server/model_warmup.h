@@ -0,0 +1,77 @@
+#pragma once
+
+// 热启动: 本地缓存解析后的模型元数据和配置, 启动时只用一次 IsModelReady 校验缓存,
+// 再按将要使用的每个批大小发送预热请求, 直到延迟稳定后才宣告就绪,
+// 避免 TensorRT 等后端首批请求的慢启动落到真实流量上
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class TritonClient;
+
+struct ModelTensorInfo {
+    std::string name;
+    std::string datatype;
+    std::vector<int64_t> shape;         // 含批维时首维为 -1
+};
+
+struct ModelInfo {
+    std::string name;
+    std::string version;                // 当前就绪的最高版本
+    std::string platform;
+    int max_batch_size = 0;             // 0 表示模型不支持批处理, 输入形状固定
+    std::vector<ModelTensorInfo> inputs;
+    std::vector<ModelTensorInfo> outputs;
+    std::vector<int> preferred_batch_sizes;
+};
+
+// 由 ModelMetadata 与 ModelConfig 返回的 JSON 解析, HTTP 与 gRPC 的输出均可
+bool ParseModelInfo(const std::string& metadata_json, const std::string& config_json,
+                    ModelInfo* info);
+bool LoadModelInfoCache(const std::string& path, ModelInfo* info);
+bool SaveModelInfoCache(const std::string& path, const ModelInfo& info);
+
+struct WarmStartConfig {
+    std::string cache_path;             // 缺省为 <模型名>.model_cache.json
+    std::vector<size_t> batch_sizes;    // 需要预热的批大小, 缺省为 1,2,4,...,max_batch_size
+    size_t max_batch = 32;              // 调用方实际使用的最大批大小
+    int stable_rounds = 3;              // 连续这么多次延迟不超过稳态的 settle_ratio 倍视为稳定
+    int max_rounds = 50;                // 单个批大小的预热请求上限
+    double settle_ratio = 1.5;
+};
+
+struct WarmupBatchReport {
+    size_t batch_size = 0;
+    int requests = 0;
+    double first_latency_ms = 0.0;      // 首个请求的延迟
+    double steady_latency_ms = 0.0;     // 预热结束时的稳态延迟
+    double good_at_ms = 0.0;            // 首次达到稳态延迟时距热启动开始的时间
+    bool stable = false;
+};
+
+struct WarmStartReport {
+    bool cache_hit = false;             // 缓存命中且通过校验
+    double metadata_ms = 0.0;           // 获取/校验模型信息的耗时
+    double time_to_first_good_ms = 0.0; // 所有批大小均达到稳态延迟的时间
+    double ready_ms = 0.0;              // 热启动总耗时
+    std::vector<WarmupBatchReport> batches;
+};
+
+// 预热使用的推理函数, 与流水线 InferFn 签名一致
+using WarmupInferFn = std::function<bool(const float* input, size_t batch_size,
+                                         std::vector<float>* output)>;
+
+// 取得模型信息并校验输入输出布局: 缓存中的版本仍就绪时只需一次 IsModelReady, 否则向服务器查询后写入缓存;
+// cache_path 为空时使用 <模型名>.model_cache.json
+bool ResolveModelInfo(TritonClient* client, const std::string& model_name,
+                      const std::string& cache_path, ModelInfo* info, bool* cache_hit = nullptr);
+
+// 取得模型信息(缓存优先)并预热, 全部批大小预热成功才返回 true
+bool WarmStart(TritonClient* client, const std::string& model_name,
+               const WarmStartConfig& config, const WarmupInferFn& infer,
+               ModelInfo* info, WarmStartReport* report);
+
+void PrintWarmStartReport(const WarmStartReport& report);
@@ -0,0 +1,579 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "hedged_client.h"
+#include "infer_backend.h"
+#include "model_router.h"
+#include "model_warmup.h"
+#include "trace_recorder.h"
+#include "track_encoder.h"
+#include "track_pipeline.h"
+#include "triton_client.h"
+
+void PrintUsage(const char* program_name) {
+    std::cout << "用法: " << program_name << " [选项]" << std::endl;
+    std::cout << "选项:" << std::endl;
+    std::cout << "  --replay FILE        回放文件 (uint32 帧长 + 帧内容)" << std::endl;
+    std::cout << "  --loops N            回放遍数 (默认: 1)" << std::endl;
+    std::cout << "  --url URL            Triton服务器地址 (默认: http 为 localhost:8000, grpc 为 localhost:8001)" << std::endl;
+    std::cout << "  --protocol P         通信协议: http, grpc, grpc-stream (默认: http)" << std::endl;
+    std::cout << "  --model MODEL        模型名称 (默认: Times_Classify)" << std::endl;
+    std::cout << "  --backend B          推理后端: triton, onnxruntime (默认: triton), onnxruntime 时忽略 Triton 专有选项" << std::endl;
+    std::cout << "  --onnx-model PATH    onnxruntime 后端加载的模型 (默认: model_repository/Times_Classify/1/Times_Classify.onnx)" << std::endl;
+    std::cout << "  --intra-threads N    onnxruntime 算子内线程数 (默认: 按物理核数)" << std::endl;
+    std::cout << "  --follow-reloads     跟踪模型重载, 请求固定到已就绪版本, 新版本就绪后切换 (不能与 --hedge 同用)" << std::endl;
+    std::cout << "  --fallback MODEL     重载期间可转移到的低优先级变体, 可重复指定" << std::endl;
+    std::cout << "  --warm-start         热启动: 用缓存的模型信息校验后预热 1..max-batch 各批大小" << std::endl;
+    std::cout << "  --model-cache PATH   模型信息缓存文件 (默认: <模型名>.model_cache.json)" << std::endl;
+    std::cout << "  --shm                窗口与结果经系统共享内存传递, 仅限与服务器同机部署" << std::endl;
+    std::cout << "  --shm-slots N        共享内存槽位数 (默认: 32)" << std::endl;
+    std::cout << "  --hedge URL/MODEL    对冲目标, 主请求超时未返回时发往此处, 可重复指定" << std::endl;
+    std::cout << "  --hedge-budget R     对冲请求占比上限 (默认: 0.05)" << std::endl;
+    std::cout << "  --max-batch N        单次推理最大批大小 (默认: 32)" << std::endl;
+    std::cout << "  --queue N            阶段间队列容量 (默认: 64)" << std::endl;
+    std::cout << "  --cpus LIST          各阶段绑定的CPU, 逗号分隔, 如 0,1,2,3,4" << std::endl;
+    std::cout << "  --step SEC           窗口重采样步长, 缺省使用航迹数据率" << std::endl;
+    std::cout << "  --publish HOST:PORT  分类结果回写到 0x1010 帧后以UDP发布, 可重复指定" << std::endl;
+    std::cout << "  --publish-mode MODE  inplace 原地修改帧 / scatter 分散-聚集拼帧 (默认: inplace)" << std::endl;
+    std::cout << "  --publish-batch N    攒够 N 帧合并为一次 sendmmsg (默认: 16)" << std::endl;
+    std::cout << "  --publish-delay-us N 首帧排队超过 N 微秒即发送, 输入空闲时立即发送 (默认: 2000)" << std::endl;
+    std::cout << "  --rolling-features   维护每条航迹的滚动运动学统计, 结束时按类别输出均值" << std::endl;
+    std::cout << "  --associate          关联不同雷达上报的同一目标, 每组只推理代表航迹, 其余沿用代表的标签" << std::endl;
+    std::cout << "  --assoc-gate M       关联位置门限, 米 (默认: 150)" << std::endl;
+    std::cout << "  --assoc-vel MPS      关联速度门限, 米/秒 (默认: 15)" << std::endl;
+    std::cout << "  --trace FILE         按航迹抽样记录各阶段耗时, 结束时写出 Chrome trace JSON" << std::endl;
+    std::cout << "  --trace-sample N     每 N 条航迹抽 1 条 (默认: 64)" << std::endl;
+    std::cout << "  --trace-server-ms N  追踪时后台每 N 毫秒查询一次模型统计, 记录服务端平均耗时 (默认: 100)" << std::endl;
+    std::cout << "  --adaptive           开启自适应批处理, 按 p99 目标调整批大小和等待时间" << std::endl;
+    std::cout << "  --target-p99 MS      自适应批处理的 p99 目标 (默认: 10)" << std::endl;
+    std::cout << "  --metrics            结束时以 Prometheus 文本格式输出批处理控制器指标" << std::endl;
+    std::cout << "  --dry-run            不连接服务器, 推理阶段输出零 (测量流水线自身开销)" << std::endl;
+    std::cout << "  --gen-synthetic FILE 生成合成回放文件后退出" << std::endl;
+    std::cout << "  --tracks N           合成数据每帧航迹数 (默认: 200)" << std::endl;
+    std::cout << "  --frames N           合成数据帧数 (默认: 500)" << std::endl;
+    std::cout << "  --radars N           合成数据的雷达路数, 同一站的融合/俯仰/方位航迹以重叠的批号上报同一批目标 (默认: 1)" << std::endl;
+    std::cout << "  --help               显示此帮助信息" << std::endl;
+}
+
+std::vector<int> ParseCpuList(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        cpus.push_back(std::stoi(item));
+    }
+    return cpus;
+}
+
+// 由本帧有标签的航迹生成分类结果, 小类沿用原值; 标签为 -1 或不在本帧的航迹不回写,
+// 只遍历有结果的航迹, 不扫描整帧
+void BuildClassifications(const TrackBatch& batch, std::vector<TrackClassification>* results) {
+    results->clear();
+    auto add = [&](int index, int label) {
+        if (index >= 0 && label >= 0) {
+            results->push_back({static_cast<uint16>(index), LabelToCategory(label),
+                                static_cast<uint8>(batch.items[index].tgt_species)});
+        }
+    };
+    for (size_t i = 0; i < batch.track_keys.size(); ++i) {
+        add(batch.track_items[i], batch.labels[i]);
+    }
+    // 被抑制的重复航迹沿用代表的标签
+    for (size_t i = 0; i < batch.fanout_keys.size(); ++i) {
+        add(batch.fanout_items[i], batch.fanout_labels[i]);
+    }
+}
+
+// 合成目标 t 在第 f 帧的站心东北天坐标(米), 与报文中的距离/方位/俯仰一致
+void SyntheticPosition(int t, int f, double* enu) {
+    const double kDegToRad = 3.14159265358979323846 / 180.0;
+    double rng = 2000.0 + (t * 100) % 5000 + 50.0 * std::sin(0.01 * f + t);
+    double azi = std::fmod(t * 7.0 + f * 0.05, 360.0) * kDegToRad;
+    double ele = 5.0 * kDegToRad;
+    enu[0] = rng * std::cos(ele) * std::sin(azi);
+    enu[1] = rng * std::cos(ele) * std::cos(azi);
+    enu[2] = rng * std::sin(ele);
+}
+
+// 生成合成回放: 每帧 tracks 条航迹, 帧间隔 0.1 秒, 目标做匀速圆周运动
+// radars > 1 时每个时刻由 radars 个站点各发一帧, 同一批目标以不同批号上报,
+// 第 0 站为融合航迹, 其余站的地心坐标带 30 米 x 站号的配准偏差
+bool WriteSyntheticReplay(const std::string& path, int tracks, int frames, int radars) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "❌ 无法写入: " << path << std::endl;
+        return false;
+    }
+
+    // msg_len 为 16 位, 单帧航迹数受帧长限制
+    const int max_tracks = static_cast<int>((0xFFFF - TrackFrameSize(0)) / sizeof(NetTrackItem_t));
+    if (tracks > max_tracks) {
+        std::cerr << "⚠️  每帧航迹数超过帧长上限, 调整为 " << max_tracks << std::endl;
+        tracks = max_tracks;
+    }
+    radars = std::max(radars, 1);
+
+    // 站点地心坐标(米), 站心东北天坐标近似按坐标轴平移到地心坐标, 只用于关联时的相对距离
+    const double kSiteEcef[3] = {-2178000.0, 4389000.0, 4070000.0};
+    std::vector<char> frame(TrackFrameSize(tracks));
+    for (int f = 0; f < frames; ++f) {
+        for (int r = 0; r < radars; ++r) {
+            OcdHead_t header;
+            memset(&header, 0, sizeof(header));
+            header.msg_code = OcdHead_t::HeadFlag;
+            header.majorCommand = kTrackFrameCommand;
+            header.msg_len = static_cast<uint16>(frame.size());
+            header.msg_index = static_cast<uint16>(f * radars + r);
+            // 每站依次上报融合、俯仰、方位三路航迹, 超过 3 路时换下一站
+            header.rdr_station_id = static_cast<uint16>(r / 3);
+            header.rdr_id = static_cast<uint16>(2 - r % 3);
+            WriteTrackFrameHeader(frame.data(), header, static_cast<uint16>(tracks));
+
+            for (int t = 0; t < tracks; ++t) {
+                NetTrackItem_t item;
+                memset(&item, 0, sizeof(item));
+                double phase = 0.01 * f + t;
+                item.status = 1;
+                // 各路批号取值范围相同, 同一批号在不同路对应不同目标
+                item.tgt_num = static_cast<uint16>((t + r * 7) % tracks + 1);
+                item.time = static_cast<uint32>((36000.0 + f * 0.1) / 25e-6);
+                item.tgt_rng = static_cast<uint32>((2000.0 + (t * 100) % 5000 + 50.0 * std::sin(phase)) * 10);
+                item.tgt_azi = static_cast<uint32>(std::fmod(t * 7.0 + f * 0.05, 360.0) * 100000);
+                item.tgt_ele = static_cast<int32>(5.0 * 100000);
+                item.radial_vel = static_cast<int32>(500 * std::cos(phase));
+                item.speed = static_cast<uint32>(100 + t % 200);
+                item.course = static_cast<uint16>(std::fmod(phase * 57.3, 360.0) * 10);
+                item.snr = static_cast<uint16>(1500 + t % 500);
+                item.rcs = static_cast<int16>(-2000 + t % 1000);
+                item.tas_prd = 100;
+
+                double enu[3];
+                double next[3];
+                SyntheticPosition(t, f, enu);
+                SyntheticPosition(t, f + 1, next);
+                enu[0] += 30.0 * r;
+                item.tgtX = static_cast<int32>((kSiteEcef[0] + enu[0]) * 100);
+                item.tgtY = static_cast<int32>((kSiteEcef[1] + enu[1]) * 100);
+                item.tgtZ = static_cast<int32>((kSiteEcef[2] + enu[2]) * 100);
+                item.tgtVX = static_cast<int32>((next[0] + 30.0 * r - enu[0]) / 0.1 * 100);
+                item.tgtVY = static_cast<int32>((next[1] - enu[1]) / 0.1 * 100);
+                item.tgtVZ = static_cast<int32>((next[2] - enu[2]) / 0.1 * 100);
+                WriteTrackItem(frame.data(), t, item);
+            }
+
+            uint32_t length = static_cast<uint32_t>(frame.size());
+            file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            file.write(frame.data(), frame.size());
+        }
+    }
+    std::cout << "✅ 已生成合成回放: " << path << " (" << frames << " 帧 x "
+              << tracks << " 航迹 x " << radars << " 路)" << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::string replay_path;
+    std::string synthetic_path;
+    std::string url;
+    TransportKind protocol = TransportKind::kHttp;
+    std::string model_name = "Times_Classify";
+    int loops = 1;
+    int tracks = 200;
+    int frames = 500;
+    int radars = 1;
+    bool dry_run = false;
+    std::vector<std::string> publish_addresses;
+    std::string publish_mode = "inplace";
+    TrackPublisherConfig publisher_config;
+    bool print_metrics = false;
+    std::string trace_path;
+    TraceConfig trace_config;
+    std::vector<HedgeTarget> hedge_targets;
+    HedgeConfig hedge_config;
+    bool use_shm = false;
+    bool warm_start = false;
+    bool follow_reloads = false;
+    ModelRouterConfig router_config;
+    WarmStartConfig warm_config;
+    SharedTensorArenaConfig arena_config;
+    InferBackendConfig backend_config;
+    PipelineConfig config;
+
+    // 解析命令行参数
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help") {
+            PrintUsage(argv[0]);
+            return 0;
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else if (arg == "--loops" && i + 1 < argc) {
+            loops = std::stoi(argv[++i]);
+        } else if (arg == "--url" && i + 1 < argc) {
+            url = argv[++i];
+        } else if (arg == "--protocol" && i + 1 < argc) {
+            if (!ParseTransportKind(argv[++i], &protocol)) {
+                std::cerr << "未知协议: " << argv[i] << std::endl;
+                PrintUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--model" && i + 1 < argc) {
+            model_name = argv[++i];
+        } else if (arg == "--hedge" && i + 1 < argc) {
+            std::string target = argv[++i];
+            size_t slash = target.find('/');
+            if (slash == std::string::npos) {
+                std::cerr << "❌ 对冲目标格式应为 URL/MODEL: " << target << std::endl;
+                return 1;
+            }
+            hedge_targets.push_back({target.substr(0, slash), target.substr(slash + 1)});
+        } else if (arg == "--backend" && i + 1 < argc) {
+            if (!ParseBackendKind(argv[++i], &backend_config.kind)) {
+                std::cerr << "未知后端: " << argv[i] << std::endl;
+                PrintUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--onnx-model" && i + 1 < argc) {
+            backend_config.onnx_path = argv[++i];
+        } else if (arg == "--intra-threads" && i + 1 < argc) {
+            backend_config.intra_op_threads = std::stoi(argv[++i]);
+        } else if (arg == "--follow-reloads") {
+            follow_reloads = true;
+        } else if (arg == "--fallback" && i + 1 < argc) {
+            router_config.models.push_back(argv[++i]);
+        } else if (arg == "--warm-start") {
+            warm_start = true;
+        } else if (arg == "--model-cache" && i + 1 < argc) {
+            warm_config.cache_path = argv[++i];
+        } else if (arg == "--shm") {
+            use_shm = true;
+        } else if (arg == "--shm-slots" && i + 1 < argc) {
+            arena_config.slots = std::stoul(argv[++i]);
+        } else if (arg == "--hedge-budget" && i + 1 < argc) {
+            hedge_config.budget_ratio = std::stod(argv[++i]);
+        } else if (arg == "--max-batch" && i + 1 < argc) {
+            config.max_infer_batch = std::stoul(argv[++i]);
+        } else if (arg == "--queue" && i + 1 < argc) {
+            config.queue_capacity = std::stoul(argv[++i]);
+        } else if (arg == "--cpus" && i + 1 < argc) {
+            config.stage_cpus = ParseCpuList(argv[++i]);
+        } else if (arg == "--step" && i + 1 < argc) {
+            config.window.step_sec = std::stod(argv[++i]);
+        } else if (arg == "--publish" && i + 1 < argc) {
+            publish_addresses.push_back(argv[++i]);
+        } else if (arg == "--publish-mode" && i + 1 < argc) {
+            publish_mode = argv[++i];
+        } else if (arg == "--publish-batch" && i + 1 < argc) {
+            publisher_config.max_frames = std::stoul(argv[++i]);
+        } else if (arg == "--publish-delay-us" && i + 1 < argc) {
+            publisher_config.max_delay_us = std::stoll(argv[++i]);
+        } else if (arg == "--adaptive") {
+            config.adaptive_batching = true;
+        } else if (arg == "--target-p99" && i + 1 < argc) {
+            config.batching.target_p99_ms = std::stod(argv[++i]);
+        } else if (arg == "--metrics") {
+            print_metrics = true;
+        } else if (arg == "--trace" && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (arg == "--trace-sample" && i + 1 < argc) {
+            trace_config.sample_one_in = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--trace-server-ms" && i + 1 < argc) {
+            trace_config.server_stats_interval_ms = std::stoll(argv[++i]);
+        } else if (arg == "--rolling-features") {
+            config.rolling_features = true;
+        } else if (arg == "--associate") {
+            config.associate_tracks = true;
+        } else if (arg == "--assoc-gate" && i + 1 < argc) {
+            config.association.gate_distance = std::stod(argv[++i]);
+        } else if (arg == "--assoc-vel" && i + 1 < argc) {
+            config.association.gate_velocity = std::stod(argv[++i]);
+        } else if (arg == "--dry-run") {
+            dry_run = true;
+        } else if (arg == "--gen-synthetic" && i + 1 < argc) {
+            synthetic_path = argv[++i];
+        } else if (arg == "--tracks" && i + 1 < argc) {
+            tracks = std::stoi(argv[++i]);
+        } else if (arg == "--frames" && i + 1 < argc) {
+            frames = std::stoi(argv[++i]);
+        } else if (arg == "--radars" && i + 1 < argc) {
+            radars = std::stoi(argv[++i]);
+        } else {
+            std::cerr << "未知参数: " << arg << std::endl;
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!synthetic_path.empty()) {
+        return WriteSyntheticReplay(synthetic_path, tracks, frames, radars) ? 0 : 1;
+    }
+
+    if (replay_path.empty()) {
+        std::cerr << "❌ 需要指定 --replay" << std::endl;
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    // 对冲客户端直接按目标发请求, 不经 ModelRouter 的版本固定和回退
+    if (follow_reloads && !hedge_targets.empty()) {
+        std::cerr << "❌ --follow-reloads 不能与 --hedge 同时使用" << std::endl;
+        return 1;
+    }
+
+    ReplayFileSource replay;
+    if (!replay.Load(replay_path)) {
+        return 1;
+    }
+    std::cout << "📂 回放文件: " << replay_path << ", " << replay.FrameCount()
+              << " 帧 x " << loops << " 遍" << std::endl;
+
+    // 先于客户端构造, 客户端析构时注销区域后才删除共享内存
+    SharedTensorArena arena;
+    if (use_shm && !arena.Create("/track_windows_" + std::to_string(getpid()), arena_config)) {
+        return 1;
+    }
+
+    std::unique_ptr<TritonClient> client;
+    std::unique_ptr<HedgedInferClient> hedged;
+    std::unique_ptr<ModelRouter> router;
+    std::unique_ptr<InferBackend> backend;
+    InferFn infer;
+    if (dry_run) {
+        infer = [](const float*, size_t batch_size, std::vector<float>* output) {
+            output->assign(batch_size * 2, 0.0f);
+            return true;
+        };
+    } else if (backend_config.kind == BackendKind::kOnnxRuntime) {
+        // 进程内推理, 共享内存、对冲、重载跟踪和热启动都只针对 Triton, 此时不生效
+        backend_config.max_batch = config.max_infer_batch;
+        backend = InferBackend::Create(backend_config);
+        if (!backend) {
+            return 1;
+        }
+        infer = [&backend](const float* input, size_t batch_size, std::vector<float>* output) {
+            return backend->InferBatch(input, batch_size, output);
+        };
+        arena.Destroy();
+        hedge_targets.clear();
+        warm_start = false;
+    } else {
+        if (url.empty()) {
+            url = DefaultTransportUrl(protocol);
+        }
+        std::cout << "🚀 连接到 Triton 服务器: " << url
+                  << " (" << TransportKindName(protocol) << ")" << std::endl;
+        client.reset(new TritonClient(url, false, protocol));
+        if (!client->CheckServerHealth()) {
+            return 1;
+        }
+        if (use_shm && hedge_targets.empty() && !client->EnableSharedMemory(&arena, SharedMemoryRegionName(arena))) {
+            // 服务器不在本机, 回退到 socket 传输
+            arena.Destroy();
+        }
+        if (follow_reloads) {
+            router_config.models.insert(router_config.models.begin(), model_name);
+            router.reset(new ModelRouter(client.get(), url, protocol, router_config));
+            if (!router->Start()) {
+                return 1;
+            }
+            infer = [&router](const float* input, size_t batch_size, std::vector<float>* output) {
+                return router->Infer(input, batch_size, output);
+            };
+        } else if (hedge_targets.empty()) {
+            infer = [&client, model_name](const float* input, size_t batch_size,
+                                          std::vector<float>* output) {
+                return client->InferBatch(model_name, input, batch_size, output);
+            };
+        } else {
+            hedge_targets.insert(hedge_targets.begin(), HedgeTarget{url, model_name});
+            for (size_t i = 0; i < hedge_targets.size(); ++i) {
+                HedgeTarget& target = hedge_targets[i];
+                target.transport = protocol;
+                // 对冲目标可能是不同后端导出的模型, 张量名按各自的元数据设置
+                if (warm_start) {
+                    TritonClient target_client(target.url, false, protocol);
+                    ModelInfo target_info;
+                    if (!ResolveModelInfo(&target_client, target.model_name,
+                                          i == 0 ? warm_config.cache_path : "", &target_info)) {
+                        std::cerr << "❌ 获取对冲目标模型信息失败: " << target.url << "/"
+                                  << target.model_name << std::endl;
+                        return 1;
+                    }
+                    target.input_name = target_info.inputs[0].name;
+                    target.output_name = target_info.outputs[0].name;
+                }
+            }
+            hedged.reset(new HedgedInferClient(hedge_targets, hedge_config));
+            if (!hedged->IsValid()) {
+                return 1;
+            }
+            infer = [&hedged](const float* input, size_t batch_size, std::vector<float>* output) {
+                return hedged->Infer(input, batch_size, output);
+            };
+        }
+    }
+
+    if (warm_start && !dry_run) {
+        ModelInfo info;
+        WarmStartReport report;
+        warm_config.max_batch = config.max_infer_batch;
+        if (!WarmStart(client.get(), model_name, warm_config, infer, &info, &report)) {
+            std::cerr << "❌ 热启动失败" << std::endl;
+            return 1;
+        }
+        PrintWarmStartReport(report);
+        // 以模型自身的批上限为准, 不支持批处理的模型每次只推理一个窗口
+        config.max_infer_batch = info.max_batch_size > 0 ?
+            std::min(config.max_infer_batch, static_cast<size_t>(info.max_batch_size)) : 1;
+    }
+
+    config.batching.max_batch = static_cast<int>(config.max_infer_batch);
+    // 对冲请求需要各自持有输入拷贝, 不使用共享内存
+    if (arena.IsValid() && hedge_targets.empty()) {
+        config.arena = &arena;
+    }
+
+    // 结果回写与发布, 仅在发布线程中访问
+    TrackFramePublisher publisher(publisher_config);
+    for (const auto& address : publish_addresses) {
+        if (!publisher.AddDestination(address)) {
+            return 1;
+        }
+    }
+    TrackFrameScatter scatter;
+    std::vector<TrackClassification> results;
+    uint64_t changed_tracks = 0;
+    PublishFn publish;
+    PublishIdleFn publish_idle;
+    if (publisher.DestinationCount() > 0) {
+        const bool use_scatter = (publish_mode == "scatter");
+        publish = [&, use_scatter](TrackBatch& batch) {
+            BuildClassifications(batch, &results);
+            const size_t tgt_num = batch.items.size();
+            if (tgt_num == 0) {
+                // 解码失败的帧原样转发
+                struct iovec iov = {batch.frame.data(), batch.frame.size()};
+                publisher.Enqueue(&iov, 1);
+            } else if (use_scatter) {
+                changed_tracks += scatter.Build(batch.frame.data(), tgt_num,
+                                                results.data(), results.size());
+                publisher.Enqueue(scatter.iov().data(), scatter.iov().size());
+            } else {
+                changed_tracks += PatchTrackClassifications(batch.frame.data(), tgt_num,
+                                                            results.data(), results.size());
+                struct iovec iov = {batch.frame.data(), TrackFrameSize(tgt_num)};
+                publisher.Enqueue(&iov, 1);
+            }
+            // 发布器引用帧内存排队, 攒够帧数或超时再由一次 sendmmsg 发出, 发出前句柄由流水线保留
+            publisher.MaybeFlush();
+            return publisher.PendingFrames();
+        };
+        publish_idle = [&publisher]() { publisher.Flush(); };
+    }
+
+    // 按分类结果汇总附加特征, 仅在发布线程中访问
+    std::map<int, std::pair<uint64_t, std::vector<double>>> rolling_by_label;
+    if (config.rolling_features) {
+        PublishFn inner = publish;
+        publish = [&rolling_by_label, inner](TrackBatch& batch) {
+            for (size_t i = 0; i < batch.labels.size(); ++i) {
+                if (batch.labels[i] < 0) {
+                    continue;
+                }
+                auto& entry = rolling_by_label[batch.labels[i]];
+                entry.second.resize(kRollingFeatureDim);
+                entry.first++;
+                for (int f = 0; f < kRollingFeatureDim; ++f) {
+                    entry.second[f] += batch.extra_features[i * kRollingFeatureDim + f];
+                }
+            }
+            return inner ? inner(batch) : 0;
+        };
+    }
+
+    // 预热请求不计入追踪
+    std::unique_ptr<ModelStatsPoller> stats_poller;
+    if (!trace_path.empty()) {
+        TraceRecorder::Instance().Enable(trace_config);
+        if (client) {
+            // 服务端耗时由后台线程周期查询, 推理请求路径上没有额外的统计请求
+            stats_poller.reset(new ModelStatsPoller(url, protocol, model_name,
+                                                    trace_config.server_stats_interval_ms));
+            if (!stats_poller->Start()) {
+                stats_poller.reset();
+            }
+        }
+    }
+
+    TrackPipeline pipeline(config, infer, publish, publish_idle);
+    pipeline.Start(replay.MakeSource(loops));
+    pipeline.Wait();
+    pipeline.PrintReport(std::cout);
+    if (!trace_path.empty()) {
+        if (stats_poller) {
+            stats_poller->Stop();
+        }
+        TraceRecorder& trace = TraceRecorder::Instance();
+        trace.Disable();
+        if (!trace.WriteChromeTrace(trace_path)) {
+            return 1;
+        }
+        std::cout << "🧭 追踪: " << trace.RecordedEvents() << " 个事件已写入 " << trace_path
+                  << ", 缓冲已满丢弃 " << trace.DroppedEvents() << std::endl;
+    }
+    if (hedged) {
+        HedgeStats stats = hedged->Stats();
+        std::cout << "🔀 对冲: 请求=" << stats.requests << " 对冲=" << stats.hedges_sent
+                  << " 对冲胜出=" << stats.hedge_wins << " 预算不足=" << stats.budget_denied
+                  << " 失败=" << stats.failures << " 对冲等待=" << stats.hedge_delay_us
+                  << "us" << std::endl;
+    }
+    if (router) {
+        router->Stop();
+        ModelRouterStats stats = router->Stats();
+        std::cout << "🔄 模型路由: 当前=" << stats.active << " 请求=" << stats.requests
+                  << " 切换=" << stats.switches << " 故障转移=" << stats.failovers
+                  << " 重试成功=" << stats.retries << " 失败=" << stats.failures
+                  << " 普通错误=" << stats.errors
+                  << " 已排空=" << stats.drained << std::endl;
+    }
+    if (config.arena) {
+        std::cout << "🧠 共享内存: " << arena.key() << ", 槽位不足回退次数: "
+                  << arena.AcquireFailures() << std::endl;
+    }
+    if (!rolling_by_label.empty()) {
+        std::cout << "\n📈 各类别滚动运动学统计均值:" << std::endl;
+        std::cout << std::setw(22) << "label";
+        for (const auto& entry : rolling_by_label) {
+            std::cout << std::setw(12) << entry.first;
+        }
+        std::cout << std::endl;
+        for (int f = 0; f < kRollingFeatureDim; ++f) {
+            std::cout << std::setw(22) << RollingFeatureName(f) << std::fixed << std::setprecision(3);
+            for (const auto& entry : rolling_by_label) {
+                std::cout << std::setw(12) << entry.second.second[f] / entry.second.first;
+            }
+            std::cout << std::endl;
+        }
+    }
+    if (print_metrics && config.adaptive_batching) {
+        pipeline.Controller().ExportPrometheus(std::cout);
+    }
+
+    if (publisher.DestinationCount() > 0) {
+        std::cout << "📤 发布报文: " << publisher.SentMessages() << ", 失败: "
+                  << publisher.SendErrors() << ", sendmmsg 调用: " << publisher.SendCalls()
+                  << ", 类别变化航迹: " << changed_tracks << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,154 @@
+// Python 绑定: 把 C++ 批量推理路径提供给分析工具, 代替逐请求调用 tritonclient.http
+//
+//   import numpy as np
+//   import track_classify
+//   client = track_classify.Client("localhost:8000", protocol="http", model="Times_Classify")
+//   logits = client.infer(windows)      # windows: float32 [N, 20, 14] -> float32 [N, 类别数]
+//   labels = client.classify(windows)   # -> int32 [N]
+//
+// C 连续的 float32 数组经缓冲区协议直接交给 C++, 不做拷贝(其他 dtype 或布局先转换一次);
+// 输出数组直接接管 C++ 结果缓冲. 推理期间释放 GIL, 其他 Python 线程照常运行,
+// 多个线程也可以同时调用同一个 Client
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "batch_infer_client.h"
+#include "infer_backend.h"
+
+namespace py = pybind11;
+
+namespace {
+
+using WindowArray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+
+class PyClassifyClient {
+public:
+    PyClassifyClient(const std::string& url, const std::string& protocol, const std::string& model,
+                     const std::string& backend, const std::string& onnx_model, size_t max_batch,
+                     size_t max_in_flight, int intra_threads) {
+        BackendKind kind;
+        if (!ParseBackendKind(backend, &kind)) {
+            throw py::value_error("未知后端: " + backend);
+        }
+        TransportKind transport;
+        if (!ParseTransportKind(protocol, &transport)) {
+            throw py::value_error("未知协议: " + protocol);
+        }
+
+        if (kind == BackendKind::kTriton) {
+            BatchInferConfig config;
+            config.model_name = model;
+            config.max_batch = max_batch;
+            config.max_in_flight = max_in_flight;
+            std::string error;
+            batch_client_.reset(new BatchInferClient(
+                url.empty() ? DefaultTransportUrl(transport) : url, transport, config, &error));
+            if (!batch_client_->IsValid()) {
+                throw std::runtime_error("创建客户端失败: " + error);
+            }
+        } else {
+            InferBackendConfig config;
+            config.kind = kind;
+            config.model_name = model;
+            config.max_batch = max_batch;
+            config.intra_op_threads = intra_threads;
+            if (!onnx_model.empty()) {
+                config.onnx_path = onnx_model;
+            }
+            backend_ = InferBackend::Create(config);
+            if (!backend_) {
+                throw std::runtime_error("创建 " + backend + " 后端失败");
+            }
+        }
+    }
+
+    py::array_t<float> Infer(const WindowArray& windows) {
+        size_t count = CheckShape(windows);
+        auto logits = std::make_unique<std::vector<float>>();
+        RunInfer(windows.data(), count, logits.get());
+
+        const size_t num_classes = count ? logits->size() / count : 0;
+        std::vector<float>* owned = logits.release();
+        py::capsule owner(owned, [](void* p) { delete static_cast<std::vector<float>*>(p); });
+        return py::array_t<float>({count, num_classes}, owned->data(), owner);
+    }
+
+    py::array_t<int32_t> Classify(const WindowArray& windows) {
+        size_t count = CheckShape(windows);
+        std::vector<float> logits;
+        RunInfer(windows.data(), count, &logits);
+
+        py::array_t<int32_t> labels(count);
+        int32_t* out = labels.mutable_data();
+        const size_t num_classes = count ? logits.size() / count : 0;
+        for (size_t i = 0; i < count; ++i) {
+            const float* row = logits.data() + i * num_classes;
+            out[i] = static_cast<int32_t>(std::max_element(row, row + num_classes) - row);
+        }
+        return labels;
+    }
+
+    uint64_t Requests() const { return batch_client_ ? batch_client_->Requests() : 0; }
+    uint64_t Failures() const { return batch_client_ ? batch_client_->Failures() : 0; }
+
+private:
+    static size_t CheckShape(const WindowArray& windows) {
+        if (windows.ndim() != 3 || windows.shape(1) != 20 || windows.shape(2) != 14) {
+            throw py::value_error("windows 形状应为 [N, 20, 14]");
+        }
+        return static_cast<size_t>(windows.shape(0));
+    }
+
+    // 调用方持有 windows 的引用, 释放 GIL 期间数组不会被回收
+    void RunInfer(const float* input, size_t count, std::vector<float>* logits) {
+        std::string error;
+        bool ok;
+        {
+            py::gil_scoped_release release;
+            if (batch_client_) {
+                ok = batch_client_->Infer(input, count, logits, &error);
+            } else {
+                // 进程内后端的预分配缓冲同一时刻只能有一个调用者
+                std::lock_guard<std::mutex> lock(backend_mutex_);
+                ok = count == 0 || backend_->InferBatch(input, count, logits);
+                error = "推理失败";
+            }
+        }
+        if (!ok) {
+            throw std::runtime_error(error);
+        }
+    }
+
+    std::unique_ptr<BatchInferClient> batch_client_;
+    std::unique_ptr<InferBackend> backend_;
+    std::mutex backend_mutex_;
+};
+
+}  // namespace
+
+PYBIND11_MODULE(track_classify, m) {
+    m.doc() = "航迹分类 C++ 批量推理路径的 Python 绑定";
+
+    py::class_<PyClassifyClient>(m, "Client")
+        .def(py::init<const std::string&, const std::string&, const std::string&, const std::string&,
+                      const std::string&, size_t, size_t, int>(),
+             py::arg("url") = "", py::arg("protocol") = "http", py::arg("model") = "Times_Classify",
+             py::arg("backend") = "triton", py::arg("onnx_model") = "", py::arg("max_batch") = 32,
+             py::arg("max_in_flight") = 4, py::arg("intra_threads") = 0,
+             "backend 为 triton 时按 max_batch 切分并保持 max_in_flight 个在途请求; "
+             "为 onnxruntime 时在进程内加载 onnx_model")
+        .def("infer", &PyClassifyClient::Infer, py::arg("windows"),
+             "windows: float32 [N, 20, 14], 返回 logits float32 [N, 类别数]")
+        .def("classify", &PyClassifyClient::Classify, py::arg("windows"),
+             "windows: float32 [N, 20, 14], 返回 argmax 类别 int32 [N]")
+        .def_property_readonly("requests", &PyClassifyClient::Requests, "已发出的请求数")
+        .def_property_readonly("failures", &PyClassifyClient::Failures, "失败的调用数");
+}
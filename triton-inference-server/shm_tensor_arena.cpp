@@ -0,0 +1,128 @@
+#include "shm_tensor_arena.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include "track_window.h"
+
+namespace {
+
+constexpr size_t kCacheLine = 64;
+
+size_t AlignUp(size_t n) {
+    return (n + kCacheLine - 1) / kCacheLine * kCacheLine;
+}
+
+constexpr size_t kWindowBytes = kWindowSteps * kFeatureDim * sizeof(float);
+
+}  // namespace
+
+SharedTensorArena::~SharedTensorArena() {
+    Destroy();
+}
+
+bool SharedTensorArena::Create(const std::string& key, const SharedTensorArenaConfig& config) {
+    Destroy();
+    config_ = config;
+    config_.slots = std::max<size_t>(config_.slots, 1);
+    config_.slot_windows = std::max<size_t>(config_.slot_windows, 1);
+    config_.num_classes = std::max<size_t>(config_.num_classes, 1);
+
+    input_bytes_ = AlignUp(config_.slot_windows * kWindowBytes);
+    slot_stride_ = input_bytes_ + AlignUp(config_.slot_windows * config_.num_classes * sizeof(float));
+    const size_t byte_size = slot_stride_ * config_.slots;
+
+    int fd = shm_open(key.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        std::cerr << "❌ 创建共享内存 " << key << " 失败: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (ftruncate(fd, byte_size) != 0) {
+        std::cerr << "❌ 设置共享内存大小失败: " << std::strerror(errno) << std::endl;
+        close(fd);
+        shm_unlink(key.c_str());
+        return false;
+    }
+    void* addr = mmap(nullptr, byte_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    // 映射建立后即可关闭描述符
+    close(fd);
+    if (addr == MAP_FAILED) {
+        std::cerr << "❌ 映射共享内存失败: " << std::strerror(errno) << std::endl;
+        shm_unlink(key.c_str());
+        return false;
+    }
+
+    key_ = key;
+    base_ = static_cast<char*>(addr);
+    byte_size_ = byte_size;
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_slots_.clear();
+    // 倒序压入, 先分配低地址槽位
+    for (size_t i = config_.slots; i > 0; --i) {
+        free_slots_.push_back(static_cast<uint32_t>(i - 1));
+    }
+    acquire_failures_ = 0;
+    return true;
+}
+
+void SharedTensorArena::Destroy() {
+    if (!base_) {
+        return;
+    }
+    munmap(base_, byte_size_);
+    shm_unlink(key_.c_str());
+    base_ = nullptr;
+    byte_size_ = 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_slots_.clear();
+}
+
+bool SharedTensorArena::Acquire(uint32_t* slot) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_slots_.empty()) {
+        acquire_failures_++;
+        return false;
+    }
+    *slot = free_slots_.back();
+    free_slots_.pop_back();
+    return true;
+}
+
+void SharedTensorArena::Release(uint32_t slot) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_slots_.push_back(slot);
+}
+
+float* SharedTensorArena::InputPtr(uint32_t slot) const {
+    return reinterpret_cast<float*>(base_ + InputOffset(slot));
+}
+
+float* SharedTensorArena::OutputPtr(uint32_t slot) const {
+    return reinterpret_cast<float*>(base_ + OutputOffset(slot));
+}
+
+bool SharedTensorArena::LocateInput(const float* ptr, uint32_t* slot, size_t* window) const {
+    const char* p = reinterpret_cast<const char*>(ptr);
+    if (!base_ || p < base_ || p >= base_ + byte_size_) {
+        return false;
+    }
+    const size_t offset = p - base_;
+    const size_t in_slot = offset % slot_stride_;
+    if (in_slot >= config_.slot_windows * kWindowBytes || in_slot % kWindowBytes != 0) {
+        return false;
+    }
+    *slot = static_cast<uint32_t>(offset / slot_stride_);
+    *window = in_slot / kWindowBytes;
+    return true;
+}
+
+uint64_t SharedTensorArena::AcquireFailures() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return acquire_failures_;
+}
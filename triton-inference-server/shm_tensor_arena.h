@@ -0,0 +1,71 @@
+#pragma once
+
+// 系统共享内存张量区: 客户端与 Triton 部署在同一主机时, 输入窗口和输出 logits 都放在
+// POSIX 共享内存中, 请求只携带区域名和偏移, 张量数据不再经过 socket
+//
+// 区域划分为若干等长槽位, 每个槽位 = 输入区 [slot_windows, 20, 14] + 输出区 [slot_windows, 类别数],
+// 一个槽位同一时刻只属于一个批次, 通过 Acquire/Release 复用
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "track_message.h"
+
+struct SharedTensorArenaConfig {
+    size_t slots = 32;              // 槽位数, 决定可同时驻留在共享内存中的批次数
+    // 每个槽位容纳的窗口数, 默认等于单帧最多航迹数, 一整帧 0x1010 报文总能放下;
+    // 跨帧攒批超出时回退到普通内存
+    size_t slot_windows = kMaxTracksPerFrame;
+    size_t num_classes = 2;         // 模型输出类别数, 与 config.pbtxt 中 output dims 一致
+};
+
+class SharedTensorArena {
+public:
+    SharedTensorArena() = default;
+    ~SharedTensorArena();
+
+    SharedTensorArena(const SharedTensorArena&) = delete;
+    SharedTensorArena& operator=(const SharedTensorArena&) = delete;
+
+    // 创建并映射共享内存, key 形如 "/track_windows", 已存在的同名区域会被覆盖
+    bool Create(const std::string& key,
+                const SharedTensorArenaConfig& config = SharedTensorArenaConfig());
+    // 解除映射并删除区域, 调用前服务端应已注销该区域
+    void Destroy();
+
+    bool IsValid() const { return base_ != nullptr; }
+    const std::string& key() const { return key_; }
+    size_t byte_size() const { return byte_size_; }
+    size_t slot_windows() const { return config_.slot_windows; }
+    size_t num_classes() const { return config_.num_classes; }
+
+    // 取一个空闲槽位, 全部占用时返回 false; 可在任意线程调用
+    bool Acquire(uint32_t* slot);
+    void Release(uint32_t slot);
+
+    float* InputPtr(uint32_t slot) const;
+    float* OutputPtr(uint32_t slot) const;
+    // 相对区域起始的字节偏移, 用于 SetSharedMemory
+    size_t InputOffset(uint32_t slot) const { return slot * slot_stride_; }
+    size_t OutputOffset(uint32_t slot) const { return slot * slot_stride_ + input_bytes_; }
+
+    // ptr 位于某槽位输入区内且按窗口对齐时返回 true, 并给出槽位号和窗口序号
+    bool LocateInput(const float* ptr, uint32_t* slot, size_t* window) const;
+
+    uint64_t AcquireFailures() const;
+
+private:
+    SharedTensorArenaConfig config_;
+    std::string key_;
+    char* base_ = nullptr;
+    size_t byte_size_ = 0;
+    size_t input_bytes_ = 0;        // 槽位内输入区字节数(按缓存行对齐)
+    size_t slot_stride_ = 0;
+
+    mutable std::mutex mutex_;
+    std::vector<uint32_t> free_slots_;
+    uint64_t acquire_failures_ = 0;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+// 有界无锁单生产者/单消费者环形队列
+// 只传递指针等小对象(批次句柄), 不拷贝批次数据
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+template <typename T>
+class SpscQueue {
+public:
+    // 容量向上取整为 2 的幂
+    explicit SpscQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        buffer_.resize(size);
+        mask_ = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // 仅生产者线程调用, 队列满时返回 false
+    bool TryPush(const T& value) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) {
+                return false;
+            }
+        }
+        buffer_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 仅消费者线程调用, 队列空时返回 false
+    bool TryPop(T* value) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        *value = buffer_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 当前占用量, 任意线程可调用(近似值)
+    size_t Size() const {
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        const size_t head = head_.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    size_t Capacity() const { return mask_ + 1; }
+
+private:
+    static constexpr size_t kCacheLine = 64;
+
+    std::vector<T> buffer_;
+    size_t mask_ = 0;
+
+    // 生产者与消费者各自的下标放在不同缓存行, 避免伪共享
+    alignas(kCacheLine) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0;    // 消费者缓存的 tail
+    alignas(kCacheLine) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;    // 生产者缓存的 head
+};
@@ -0,0 +1,247 @@
+#include "trace_recorder.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+std::atomic<bool> TraceRecorder::enabled_{false};
+
+namespace {
+
+thread_local uint64_t g_context_batch = 0;
+
+// 名字来自代码中的字面量或线程名, 只需转义引号、反斜杠和控制字符
+void WriteJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out << buf;
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+uint32_t MixKey(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    return static_cast<uint32_t>(value);
+}
+
+}  // namespace
+
+TraceRecorder& TraceRecorder::Instance() {
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+void TraceRecorder::Enable(const TraceConfig& config) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        config_ = config;
+        if (config_.sample_one_in == 0) {
+            config_.sample_one_in = 1;
+        }
+    }
+    enabled_.store(true, std::memory_order_release);
+}
+
+void TraceRecorder::Disable() {
+    enabled_.store(false, std::memory_order_release);
+}
+
+bool TraceRecorder::SampleTrack(uint64_t track_key) const {
+    // 按键哈希固定抽样, 同一条航迹在整个运行期间要么全部记录要么全部不记录
+    return MixKey(track_key) % config_.sample_one_in == 0;
+}
+
+void TraceRecorder::SetContextBatch(uint64_t batch_id) {
+    g_context_batch = batch_id;
+}
+
+uint64_t TraceRecorder::ContextBatch() {
+    return g_context_batch;
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::LocalBuffer() {
+    thread_local ThreadBuffer* local = nullptr;
+    if (local == nullptr) {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffer->capacity = config_.events_per_thread;
+        buffer->events.reset(new Event[buffer->capacity]);
+        buffer->tid = static_cast<uint32_t>(buffers_.size() + 1);
+        local = buffer.get();
+        buffers_.push_back(std::move(buffer));
+    }
+    return local;
+}
+
+void TraceRecorder::Record(const Event& event) {
+    ThreadBuffer* buffer = LocalBuffer();
+    size_t index = buffer->committed.load(std::memory_order_relaxed);
+    if (index >= buffer->capacity) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer->events[index] = event;
+    // 先写事件再发布下标, 导出线程 acquire 读取下标后看到的事件都已写完
+    buffer->committed.store(index + 1, std::memory_order_release);
+}
+
+void TraceRecorder::Complete(const char* name, const char* category, TraceClock::time_point begin,
+                             TraceClock::time_point end, const TraceArgs& args, uint64_t row) {
+    Event event;
+    event.name = name;
+    event.category = category;
+    event.phase = 'X';
+    event.ts_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(begin - origin_).count();
+    event.dur_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+    event.row = row;
+    event.args = args;
+    Record(event);
+}
+
+void TraceRecorder::Instant(const char* name, const char* category, TraceClock::time_point at,
+                            const TraceArgs& args, uint64_t row) {
+    Event event;
+    event.name = name;
+    event.category = category;
+    event.phase = 'i';
+    event.ts_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(at - origin_).count();
+    event.dur_ns = 0;
+    event.row = row;
+    event.args = args;
+    Record(event);
+}
+
+void TraceRecorder::SetThreadName(const std::string& name) {
+    ThreadBuffer* buffer = LocalBuffer();
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffer->name = name;
+}
+
+void TraceRecorder::SetRowName(uint64_t row, const std::string& name) {
+    // 虚拟行的事件与命名在同一线程记录, 该线程缓冲写满后新行不会再有事件, 名字也不再保存
+    ThreadBuffer* buffer = LocalBuffer();
+    if (buffer->committed.load(std::memory_order_relaxed) >= buffer->capacity) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    row_names_[row] = name;
+}
+
+bool TraceRecorder::WriteChromeTrace(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "❌ 无法写入追踪文件: " << path << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) {
+            out << ",\n";
+        }
+        first = false;
+    };
+
+    for (const auto& buffer : buffers_) {
+        separator();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+            << ",\"args\":{\"name\":";
+        WriteJsonString(out, buffer->name.empty() ? "thread-" + std::to_string(buffer->tid) : buffer->name);
+        out << "}}";
+    }
+    for (const auto& entry : row_names_) {
+        separator();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << entry.first
+            << ",\"args\":{\"name\":";
+        WriteJsonString(out, entry.second);
+        out << "}}";
+    }
+
+    char number[64];
+    for (const auto& buffer : buffers_) {
+        size_t count = buffer->committed.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i) {
+            const Event& event = buffer->events[i];
+            separator();
+            out << "{\"name\":";
+            WriteJsonString(out, event.name);
+            out << ",\"cat\":";
+            WriteJsonString(out, event.category);
+            // 时间单位为微秒, 保留到纳秒
+            std::snprintf(number, sizeof(number), "%.3f", event.ts_ns / 1000.0);
+            out << ",\"ph\":\"" << event.phase << "\",\"ts\":" << number;
+            if (event.phase == 'X') {
+                std::snprintf(number, sizeof(number), "%.3f", event.dur_ns / 1000.0);
+                out << ",\"dur\":" << number;
+            } else {
+                out << ",\"s\":\"t\"";
+            }
+            out << ",\"pid\":1,\"tid\":" << (event.row != 0 ? event.row : buffer->tid) << ",\"args\":{";
+            const TraceArgs& args = event.args;
+            bool first_arg = true;
+            auto field = [&](const char* key) {
+                out << (first_arg ? "" : ",") << '"' << key << "\":";
+                first_arg = false;
+            };
+            if (args.track >= 0) {
+                field("track");
+                out << args.track;
+            }
+            if (args.msg_index >= 0) {
+                field("msg_index");
+                out << args.msg_index;
+            }
+            if (args.frame >= 0) {
+                field("frame");
+                out << args.frame;
+            }
+            if (args.batch >= 0) {
+                field("batch");
+                out << args.batch;
+            }
+            if (args.value_name != nullptr) {
+                field(args.value_name);
+                std::snprintf(number, sizeof(number), "%.3f", args.value);
+                out << number;
+            }
+            out << "}}";
+        }
+    }
+    out << "\n]}\n";
+
+    if (!out) {
+        std::cerr << "❌ 追踪文件写入失败: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+uint64_t TraceRecorder::RecordedEvents() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t total = 0;
+    for (const auto& buffer : buffers_) {
+        total += buffer->committed.load(std::memory_order_acquire);
+    }
+    return total;
+}
+
+uint64_t TraceRecorder::DroppedEvents() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t total = 0;
+    for (const auto& buffer : buffers_) {
+        total += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+// 请求追踪: 按航迹抽样记录一帧从接收、解码、窗口就绪、攒批等待、推理请求到发布的各段耗时,
+// 导出为 Chrome trace-event JSON, 可直接用 chrome://tracing 或 Perfetto 打开
+//
+// 每个线程写入自己的定长缓冲(单写者, 仅一次 release 存储发布), 导出时只读取已发布的部分,
+// 记录与导出之间无锁; 未开启时每个埋点只有一次 relaxed 原子读
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using TraceClock = std::chrono::steady_clock;
+
+struct TraceConfig {
+    uint32_t sample_one_in = 64;        // 每 N 条航迹抽 1 条记录完整经过, 按航迹键固定抽样
+    int64_t server_stats_interval_ms = 100; // 后台查询服务端统计的周期, 见 ModelStatsPoller
+    size_t events_per_thread = 1 << 16; // 每线程缓冲的事件数, 写满后丢弃并计数
+};
+
+// 事件附带的参数, 取默认值的字段不输出
+struct TraceArgs {
+    int64_t track = -1;                 // 航迹键
+    int64_t msg_index = -1;             // 帧序列号
+    int64_t frame = -1;                 // 流水线内的帧序号
+    int64_t batch = -1;                 // 推理批次号
+    const char* value_name = nullptr;   // 额外数值参数名(静态字符串)
+    double value = 0.0;
+};
+
+class TraceRecorder {
+public:
+    static TraceRecorder& Instance();
+
+    static bool Enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    void Enable(const TraceConfig& config = TraceConfig());
+    void Disable();
+
+    bool SampleTrack(uint64_t track_key) const;
+
+    // 当前线程正在处理的推理批次号, 供传输层给请求区间打标签
+    static void SetContextBatch(uint64_t batch_id);
+    static uint64_t ContextBatch();
+
+    // 在当前线程的时间线上记录一段耗时; row 非 0 时记录在以 row 标识的虚拟行上(如单条航迹)
+    void Complete(const char* name, const char* category, TraceClock::time_point begin,
+                  TraceClock::time_point end, const TraceArgs& args = TraceArgs(), uint64_t row = 0);
+    void Instant(const char* name, const char* category, TraceClock::time_point at,
+                 const TraceArgs& args = TraceArgs(), uint64_t row = 0);
+    // 当前线程在时间线上显示的名字
+    void SetThreadName(const std::string& name);
+    // 虚拟行的显示名字, 仅在导出时使用; 应在记录该行事件的线程上调用, 该线程缓冲写满后忽略
+    void SetRowName(uint64_t row, const std::string& name);
+
+    // 导出到目前为止记录的全部事件, 记录可以继续进行
+    bool WriteChromeTrace(const std::string& path) const;
+
+    uint64_t RecordedEvents() const;
+    uint64_t DroppedEvents() const;
+
+private:
+    struct Event {
+        const char* name;
+        const char* category;
+        char phase;                     // 'X' 完整区间, 'i' 瞬时
+        int64_t ts_ns;                  // 相对追踪起点
+        int64_t dur_ns;
+        uint64_t row;
+        TraceArgs args;
+    };
+
+    struct ThreadBuffer {
+        std::unique_ptr<Event[]> events;
+        size_t capacity = 0;
+        std::atomic<size_t> committed{0};
+        std::atomic<uint64_t> dropped{0};
+        uint32_t tid = 0;
+        std::string name;
+    };
+
+    TraceRecorder() = default;
+    ThreadBuffer* LocalBuffer();
+    void Record(const Event& event);
+
+    static std::atomic<bool> enabled_;
+
+    TraceConfig config_;
+    TraceClock::time_point origin_ = TraceClock::now();
+
+    mutable std::mutex mutex_;          // 仅保护注册表, 不在记录路径上
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    std::unordered_map<uint64_t, std::string> row_names_;    // 同一行只保留最后一次的名字
+};
@@ -0,0 +1,168 @@
+#include "track_association.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+TrackSpatialIndexConfig MakeIndexConfig(const TrackAssociationConfig& config) {
+    // 单级网格, 边长等于查询半径, 每次查询只扫描 3x3x3 个网格
+    TrackSpatialIndexConfig index;
+    index.cell_size = config.search_radius;
+    index.levels = 1;
+    index.bucket_count = config.bucket_count;
+    return index;
+}
+
+}  // namespace
+
+TrackAssociator::TrackAssociator(const TrackAssociationConfig& config)
+    : config_(config), index_(MakeIndexConfig(config)) {}
+
+void TrackAssociator::UpdateFrame(const OcdHead_t& header, const NetTrackItem_t* items,
+                                  size_t count) {
+    const uint32_t source = (static_cast<uint32_t>(header.rdr_station_id) << 16) | header.rdr_id;
+    const bool fused = header.rdr_id == 2;
+    for (size_t i = 0; i < count; ++i) {
+        const NetTrackItem_t& item = items[i];
+        TrackKey key = MakeTrackKey(header, item);
+        if (item.status == 0) {
+            // 目标丢失
+            Remove(key);
+            continue;
+        }
+        if (item.status > 2) {
+            continue;
+        }
+        // 地心坐标和速度量化单位均为 0.01
+        const double pos[3] = {item.tgtX * 0.01, item.tgtY * 0.01, item.tgtZ * 0.01};
+        const double vel[3] = {item.tgtVX * 0.01, item.tgtVY * 0.01, item.tgtVZ * 0.01};
+        Update(key, source, fused, TrackTimeOfDay(header, item), pos, vel);
+    }
+}
+
+void TrackAssociator::Update(TrackKey track_key, uint32_t source, bool fused, double t,
+                             const double* pos, const double* vel) {
+    auto inserted = states_.emplace(track_key, TrackState());
+    TrackState& s = inserted.first->second;
+    if (inserted.second) {
+        s.rep = track_key;
+    }
+    s.source = source;
+    s.fused = fused;
+    s.hits++;
+    s.t = t;
+    std::copy(pos, pos + 3, s.pos);
+    std::copy(vel, vel + 3, s.vel);
+    index_.Update(track_key, pos[0], pos[1], pos[2]);
+    stats_.updates++;
+
+    // 已归组: 代表仍存在且满足门限时保持不变
+    if (s.rep != track_key) {
+        auto rep = states_.find(s.rep);
+        if (rep != states_.end() && rep->second.rep == rep->first) {
+            stats_.gate_checks++;
+            if (Gated(s, rep->second)) {
+                return;
+            }
+        }
+        s.rep = track_key;
+        stats_.splits++;
+    }
+
+    // 附近其他雷达的代表航迹中, 取满足门限且归一化距离最小的作为匹配;
+    // 匹配比自身更适合作代表时归入, 否则自身保持代表, 由对方下次更新时归入自身
+    neighbors_.clear();
+    index_.QueryRadius(pos[0], pos[1], pos[2], config_.search_radius, &neighbors_);
+    TrackKey match_key = track_key;
+    const TrackState* match = nullptr;
+    double match_cost = 0.0;
+    for (const TrackNeighbor& neighbor : neighbors_) {
+        if (neighbor.key == track_key) {
+            continue;
+        }
+        const TrackState& other = states_.find(neighbor.key)->second;
+        if (other.source == source || other.rep != neighbor.key) {
+            continue;
+        }
+        stats_.gate_checks++;
+        double cost;
+        if (Gated(s, other, &cost) && (!match || cost < match_cost)) {
+            match_key = neighbor.key;
+            match = &other;
+            match_cost = cost;
+        }
+    }
+    if (match && Preferred(match_key, *match, track_key, s)) {
+        s.rep = match_key;
+        stats_.joins++;
+    }
+}
+
+void TrackAssociator::Remove(TrackKey track_key) {
+    // 以此为代表的航迹在 RepresentativeOf 中视为自身代表, 下次更新时重新关联
+    if (states_.erase(track_key) > 0) {
+        index_.Remove(track_key);
+    }
+}
+
+void TrackAssociator::Clear() {
+    states_.clear();
+    index_.Clear();
+    stats_ = TrackAssociationStats();
+}
+
+bool TrackAssociator::IsRepresentative(TrackKey track_key) const {
+    auto it = states_.find(track_key);
+    return it != states_.end() && it->second.rep == track_key;
+}
+
+TrackKey TrackAssociator::RepresentativeOf(TrackKey track_key) const {
+    auto it = states_.find(track_key);
+    if (it == states_.end() || it->second.rep == track_key || !IsRepresentative(it->second.rep)) {
+        return track_key;
+    }
+    return it->second.rep;
+}
+
+bool TrackAssociator::Gated(const TrackState& a, const TrackState& b, double* cost) const {
+    const double dt = a.t - b.t;
+    if (std::fabs(dt) > config_.max_time_diff) {
+        return false;
+    }
+    double dist2 = 0.0;
+    double dvel2 = 0.0;
+    for (int i = 0; i < 3; ++i) {
+        double d = a.pos[i] - (b.pos[i] + b.vel[i] * dt);
+        double v = a.vel[i] - b.vel[i];
+        dist2 += d * d;
+        dvel2 += v * v;
+    }
+    const double dist_norm = dist2 / (config_.gate_distance * config_.gate_distance);
+    const double vel_norm = dvel2 / (config_.gate_velocity * config_.gate_velocity);
+    if (cost) {
+        *cost = dist_norm + vel_norm;
+    }
+    return dist_norm <= 1.0 && vel_norm <= 1.0;
+}
+
+bool TrackAssociator::Preferred(TrackKey a_key, const TrackState& a, TrackKey b_key,
+                                const TrackState& b) {
+    if (a.fused != b.fused) {
+        return a.fused;
+    }
+    if (a.hits != b.hits) {
+        return a.hits > b.hits;
+    }
+    return a_key < b_key;
+}
+
+TrackAssociationStats TrackAssociator::Stats() const {
+    TrackAssociationStats stats = stats_;
+    stats.tracks = states_.size();
+    stats.suppressed = 0;
+    for (const auto& entry : states_) {
+        stats.suppressed += RepresentativeOf(entry.first) != entry.first ? 1 : 0;
+    }
+    return stats;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+// 跨雷达重复航迹关联: 多个站点/雷达(方位、俯仰、融合)会以不同批号上报同一个目标,
+// 按地心坐标和速度把这些航迹归为一组, 每组只选一条代表送去分类, 其余沿用代表的结果
+//
+// 每条航迹更新时在空间哈希(TrackSpatialIndex)中查询附近航迹, 只与其他雷达的代表航迹比较:
+// 把对方外推到本航迹时刻后位置差不超过 gate_distance、速度矢量差不超过 gate_velocity 即满足门限,
+// 多个满足时取归一化距离最小者; 单次更新的开销只与附近航迹数有关, 整帧近似线性
+//
+// 代表优先取融合航迹(rdr_id 2), 其次取更新次数多(窗口历史更完整)的航迹;
+// 已归组的航迹只要代表仍存在且满足门限就保持不变, 避免结果在两条航迹间来回切换
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "track_message.h"
+#include "track_spatial_index.h"
+
+struct TrackAssociationConfig {
+    double gate_distance = 150.0;   // 外推到同一时刻后的位置门限(米), 取站间配准误差的量级
+    double gate_velocity = 15.0;    // 速度矢量差门限(米/秒)
+    double max_time_diff = 2.0;     // 两条航迹最近一次更新相差超过此值(秒)时不比较
+    // 空间哈希查询半径(米), 应覆盖 gate_distance + 常见速度 x 两雷达更新时间差
+    double search_radius = 1000.0;
+    size_t bucket_count = 4096;     // 哈希桶数, 取不小于航迹数 2 倍的 2 的幂
+};
+
+struct TrackAssociationStats {
+    size_t tracks = 0;              // 当前航迹数
+    size_t suppressed = 0;          // 当前归入其他代表、不单独分类的航迹数
+    uint64_t updates = 0;           // 航迹点更新次数
+    uint64_t joins = 0;             // 航迹归入代表的次数
+    uint64_t splits = 0;            // 代表消失或不再满足门限而脱离分组的次数
+    uint64_t gate_checks = 0;       // 门限比较次数, 反映关联开销
+};
+
+class TrackAssociator {
+public:
+    explicit TrackAssociator(const TrackAssociationConfig& config = TrackAssociationConfig());
+
+    // 写入一帧解码后的航迹: 状态 0 删除, 1/2 按地心坐标和速度更新并重新关联, 其余忽略
+    void UpdateFrame(const OcdHead_t& header, const NetTrackItem_t* items, size_t count);
+
+    // source 区分雷达(同一雷达的航迹之间不关联), t 为当日秒, pos/vel 为地心坐标(米, 米/秒)
+    void Update(TrackKey track_key, uint32_t source, bool fused, double t,
+                const double* pos, const double* vel);
+    void Remove(TrackKey track_key);
+    void Clear();
+
+    // 航迹所在分组的代表; 未登记、自身即代表或代表已失效时返回 track_key
+    TrackKey RepresentativeOf(TrackKey track_key) const;
+    bool IsSuppressed(TrackKey track_key) const { return RepresentativeOf(track_key) != track_key; }
+
+    // suppressed 需要遍历全部航迹, 只在汇报时调用
+    TrackAssociationStats Stats() const;
+    const TrackAssociationConfig& config() const { return config_; }
+
+private:
+    struct TrackState {
+        uint32_t source = 0;
+        bool fused = false;
+        uint32_t hits = 0;          // 更新次数
+        TrackKey rep = 0;           // 代表航迹键, 等于自身键时本航迹为代表
+        double t = 0.0;
+        double pos[3] = {0.0, 0.0, 0.0};
+        double vel[3] = {0.0, 0.0, 0.0};
+    };
+
+    // b 外推到 a 的时刻后是否满足位置和速度门限, cost 返回按门限归一化的距离平方和
+    bool Gated(const TrackState& a, const TrackState& b, double* cost = nullptr) const;
+    // a 是否比 b 更适合作代表
+    static bool Preferred(TrackKey a_key, const TrackState& a, TrackKey b_key, const TrackState& b);
+    bool IsRepresentative(TrackKey track_key) const;
+
+    TrackAssociationConfig config_;
+    TrackSpatialIndex index_;
+    std::unordered_map<TrackKey, TrackState> states_;
+    std::vector<TrackNeighbor> neighbors_;
+    TrackAssociationStats stats_;
+};
@@ -0,0 +1,278 @@
+#include "track_encoder.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <netdb.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+static_assert(offsetof(NetTrackItem_t, rcs) + sizeof(int16) == kCategoryWordOffset,
+              "tgt_category 应紧跟 rcs 之后");
+
+#ifdef IOV_MAX
+constexpr size_t kMaxIov = IOV_MAX;
+#else
+constexpr size_t kMaxIov = 1024;
+#endif
+
+static_assert(item_wire::TgtCategory::kOffset == kCategoryWordOffset &&
+              item_wire::TgtSpecies::kOffset == kCategoryWordOffset,
+              "tgt_category/tgt_species 应位于同一个字");
+
+// 按报文字节序读写 16 位字
+uint16 ReadWord(const char* p) {
+    return LoadWireWord<kTrackWireEndian, sizeof(uint16)>(p);
+}
+
+void WriteWord(char* p, uint16 value) {
+    StoreWireWord<kTrackWireEndian, sizeof(uint16)>(p, value);
+}
+
+// tgt_category 在低 8 位, tgt_species 在高 8 位
+uint16 CategoryWord(const TrackClassification& result) {
+    return static_cast<uint16>(result.category | (result.species << 8));
+}
+
+int64_t NowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+uint8 LabelToCategory(int label) {
+    switch (label) {
+        case 0: return kCategoryBird;
+        case 1: return kCategoryUav;
+        default: return kCategoryUnknown;
+    }
+}
+
+size_t PatchTrackClassifications(char* frame, size_t tgt_num,
+                                 const TrackClassification* results, size_t count) {
+    size_t changed = 0;
+    uint16 delta = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (results[i].index >= tgt_num) {
+            continue;
+        }
+        char* word = frame + TrackItemOffset(results[i].index) + kCategoryWordOffset;
+        uint16 old_value = ReadWord(word);
+        uint16 new_value = CategoryWord(results[i]);
+        if (old_value == new_value) {
+            continue;
+        }
+        WriteWord(word, new_value);
+        // 累加和校验可增量更新, 无需重新遍历整帧
+        delta = static_cast<uint16>(delta + new_value - old_value);
+        changed++;
+    }
+
+    if (changed > 0) {
+        char* check_sum = frame + ChecksumOffset(tgt_num);
+        WriteWord(check_sum, static_cast<uint16>(ReadWord(check_sum) + delta));
+    }
+    return changed;
+}
+
+size_t TrackFrameScatter::Build(char* frame, size_t tgt_num,
+                                const TrackClassification* results, size_t count) {
+    iov_.clear();
+    patch_words_.clear();
+    byte_size_ = TrackFrameSize(tgt_num);
+
+    // 每个补丁占 2 个 iovec, 另有校验和补丁及首尾片段
+    if (count * 2 + 3 > kMaxIov) {
+        size_t changed = PatchTrackClassifications(frame, tgt_num, results, count);
+        iov_.push_back({frame, byte_size_});
+        return changed;
+    }
+
+    // 按帧内顺序排列, 同一航迹出现多次时以最后一次为准
+    std::vector<TrackClassification> sorted(results, results + count);
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const TrackClassification& a, const TrackClassification& b) {
+                         return a.index < b.index;
+                     });
+
+    // 预留空间, 保证 iovec 中的补丁指针不会因扩容失效
+    patch_words_.reserve(sorted.size() + 1);
+
+    size_t pos = 0;
+    size_t changed = 0;
+    uint16 delta = 0;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        const TrackClassification& result = sorted[i];
+        if (result.index >= tgt_num ||
+            (i + 1 < sorted.size() && sorted[i + 1].index == result.index)) {
+            continue;
+        }
+        size_t offset = TrackItemOffset(result.index) + kCategoryWordOffset;
+        uint16 old_value = ReadWord(frame + offset);
+        uint16 new_value = CategoryWord(result);
+        if (old_value == new_value) {
+            continue;
+        }
+
+        iov_.push_back({frame + pos, offset - pos});
+        patch_words_.push_back(0);
+        WriteWord(reinterpret_cast<char*>(&patch_words_.back()), new_value);
+        iov_.push_back({&patch_words_.back(), sizeof(uint16)});
+        pos = offset + sizeof(uint16);
+        delta = static_cast<uint16>(delta + new_value - old_value);
+        changed++;
+    }
+
+    if (changed == 0) {
+        iov_.push_back({frame, byte_size_});
+        return 0;
+    }
+
+    size_t check_sum = ChecksumOffset(tgt_num);
+    iov_.push_back({frame + pos, check_sum - pos});
+    patch_words_.push_back(0);
+    WriteWord(reinterpret_cast<char*>(&patch_words_.back()),
+              static_cast<uint16>(ReadWord(frame + check_sum) + delta));
+    iov_.push_back({&patch_words_.back(), sizeof(uint16)});
+    pos = check_sum + sizeof(uint16);
+    iov_.push_back({frame + pos, byte_size_ - pos});
+    return changed;
+}
+
+TrackFramePublisher::TrackFramePublisher(const TrackPublisherConfig& config) : config_(config) {
+    config_.max_frames = std::max<size_t>(config_.max_frames, 1);
+}
+
+TrackFramePublisher::~TrackFramePublisher() {
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+bool TrackFramePublisher::EnsureSocket() {
+    if (fd_ >= 0) {
+        return true;
+    }
+    fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd_ < 0) {
+        std::cerr << "❌ 创建UDP套接字失败: " << strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool TrackFramePublisher::AddDestination(const std::string& address) {
+    size_t colon = address.rfind(':');
+    if (colon == std::string::npos) {
+        std::cerr << "❌ 目的地址格式应为 host:port: " << address << std::endl;
+        return false;
+    }
+    std::string host = address.substr(0, colon);
+    std::string port = address.substr(colon + 1);
+
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    struct addrinfo* info = nullptr;
+    int ret = getaddrinfo(host.c_str(), port.c_str(), &hints, &info);
+    if (ret != 0 || !info) {
+        std::cerr << "❌ 解析目的地址失败: " << address << " (" << gai_strerror(ret) << ")" << std::endl;
+        return false;
+    }
+    struct sockaddr_in dest;
+    memcpy(&dest, info->ai_addr, sizeof(dest));
+    freeaddrinfo(info);
+
+    if (!EnsureSocket()) {
+        return false;
+    }
+    destinations_.push_back(dest);
+    return true;
+}
+
+void TrackFramePublisher::Enqueue(const struct iovec* iov, size_t iov_count) {
+    if (pending_frames_.empty()) {
+        pending_since_us_ = NowUs();
+    }
+    // 原帧片段只记指针, 补丁字所在的缓冲会被下一帧复用, 需拷贝
+    const size_t begin = pending_segments_.size();
+    for (size_t i = 0; i < iov_count; ++i) {
+        const char* base = static_cast<const char*>(iov[i].iov_base);
+        const size_t length = iov[i].iov_len;
+        if (length > kInlineSegmentBytes) {
+            pending_segments_.push_back({base, 0, length});
+        } else {
+            pending_segments_.push_back({nullptr, inline_data_.size(), length});
+            inline_data_.insert(inline_data_.end(), base, base + length);
+        }
+    }
+    pending_frames_.emplace_back(begin, iov_count);
+}
+
+int TrackFramePublisher::MaybeFlush() {
+    if (pending_frames_.empty()) {
+        return 0;
+    }
+    if (pending_frames_.size() >= config_.max_frames ||
+        NowUs() - pending_since_us_ >= config_.max_delay_us) {
+        return Flush();
+    }
+    return 0;
+}
+
+int TrackFramePublisher::Flush() {
+    if (pending_frames_.empty() || destinations_.empty()) {
+        pending_frames_.clear();
+        pending_segments_.clear();
+        inline_data_.clear();
+        return 0;
+    }
+
+    // inline_data_ 不再增长, 此时取地址才稳定; iov_ 先填满再取地址
+    iov_.clear();
+    for (const Segment& segment : pending_segments_) {
+        const char* base = segment.base ? segment.base : inline_data_.data() + segment.offset;
+        iov_.push_back({const_cast<char*>(base), segment.length});
+    }
+    messages_.clear();
+    for (const auto& frame : pending_frames_) {
+        for (auto& dest : destinations_) {
+            struct mmsghdr message;
+            memset(&message, 0, sizeof(message));
+            message.msg_hdr.msg_name = &dest;
+            message.msg_hdr.msg_namelen = sizeof(dest);
+            message.msg_hdr.msg_iov = iov_.data() + frame.first;
+            message.msg_hdr.msg_iovlen = frame.second;
+            messages_.push_back(message);
+        }
+    }
+
+    size_t sent = 0;
+    while (sent < messages_.size()) {
+        int ret = sendmmsg(fd_, messages_.data() + sent,
+                           static_cast<unsigned int>(messages_.size() - sent), 0);
+        send_calls_++;
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // 放弃剩余报文, 不阻塞发布线程
+            send_errors_ += messages_.size() - sent;
+            break;
+        }
+        sent += ret;
+    }
+
+    sent_messages_ += sent;
+    pending_frames_.clear();
+    pending_segments_.clear();
+    inline_data_.clear();
+    return static_cast<int>(sent);
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+// 航迹报文回写: 把分类结果写入 0x1010 帧的 tgt_category/tgt_species 并更新校验和
+// 只改动结果变化的航迹所在的字, 发布开销与变化航迹数成正比
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "track_message.h"
+
+// 识别信息大类, 见 NetTrackItem_t::tgt_category
+enum TrackCategory : uint8 {
+    kCategoryBird = 1,
+    kCategoryBalloon = 2,
+    kCategoryAircraft = 3,
+    kCategoryVehicle = 4,
+    kCategoryBigBird = 5,
+    kCategorySmallBird = 6,
+    kCategoryUav = 7,
+    kCategoryUnknown = 0xf,
+};
+
+// 模型输出标签(0-bird, 1-uav)转识别大类
+uint8 LabelToCategory(int label);
+
+// 单条航迹的分类结果, index 为航迹在帧内的序号
+struct TrackClassification {
+    uint16 index;
+    uint8 category;
+    uint8 species;
+};
+
+// tgt_category/tgt_species 所在字([55])在航迹内的字节偏移
+constexpr size_t kCategoryWordOffset = (55 - 13) * 2;
+
+// 校验和(帧头至最后一条航迹所有 16 位字的累加和, 截断为 16 位)在帧内的字节偏移
+inline size_t ChecksumOffset(size_t tgt_num) {
+    return TrackItemOffset(tgt_num);
+}
+
+// 原地回写分类结果并增量更新校验和, 返回实际改变的航迹数
+// frame 必须是通过 ParseTrackFrameHeader 校验的完整帧
+size_t PatchTrackClassifications(char* frame, size_t tgt_num,
+                                 const TrackClassification* results, size_t count);
+
+// 分散-聚集回写: 不修改原帧, 由原帧未改动的片段和补丁字拼成新帧
+// iovec 指向 frame 与本对象内部的补丁字, 补丁字在下次 Build 前有效, frame 在发送完成前必须保持有效
+class TrackFrameScatter {
+public:
+    // 返回改变的航迹数; 补丁数超过 IOV_MAX 限制时退化为原地回写 frame, iovec 只含整帧
+    size_t Build(char* frame, size_t tgt_num,
+                 const TrackClassification* results, size_t count);
+
+    const std::vector<struct iovec>& iov() const { return iov_; }
+    size_t ByteSize() const { return byte_size_; }
+
+private:
+    std::vector<struct iovec> iov_;
+    std::vector<uint16> patch_words_;   // 补丁字(报文字节序), 最后一个为新校验和
+    size_t byte_size_ = 0;
+};
+
+struct TrackPublisherConfig {
+    // 跨帧合并发送: 排队帧数达到 max_frames 或最早一帧已等待 max_delay_us 时 MaybeFlush 发送
+    size_t max_frames = 16;
+    int64_t max_delay_us = 2000;
+};
+
+// 使用 sendmmsg 把帧发往一个或多个 UDP 目的地址, 多帧攒在一起由一次系统调用发送
+class TrackFramePublisher {
+public:
+    explicit TrackFramePublisher(const TrackPublisherConfig& config = TrackPublisherConfig());
+    ~TrackFramePublisher();
+
+    TrackFramePublisher(const TrackFramePublisher&) = delete;
+    TrackFramePublisher& operator=(const TrackFramePublisher&) = delete;
+
+    // 添加目的地址, 格式 host:port
+    bool AddDestination(const std::string& address);
+    size_t DestinationCount() const { return destinations_.size(); }
+
+    // 排队一帧, 每个目的地址各发一份; 不超过 kInlineSegmentBytes 的片段(补丁字、校验和)拷贝到内部缓冲,
+    // 其余片段只记下指针, 其内存在该帧由 MaybeFlush/Flush 发出前必须保持有效
+    void Enqueue(const struct iovec* iov, size_t iov_count);
+    // 达到帧数或等待时间阈值时发送, 返回成功发送的报文数
+    int MaybeFlush();
+    // 发送全部排队的报文(空闲或结束时调用), 返回成功发送的报文数
+    int Flush();
+
+    size_t PendingFrames() const { return pending_frames_.size(); }
+    uint64_t SentMessages() const { return sent_messages_; }
+    uint64_t SendErrors() const { return send_errors_; }
+    uint64_t SendCalls() const { return send_calls_; }
+
+    static constexpr size_t kInlineSegmentBytes = 8;
+
+private:
+    // 排队的报文片段: base 为空时数据在 inline_data_ 的 offset 处
+    struct Segment {
+        const char* base;
+        size_t offset;
+        size_t length;
+    };
+
+    bool EnsureSocket();
+
+    TrackPublisherConfig config_;
+    int fd_ = -1;
+    std::vector<struct sockaddr_in> destinations_;
+    std::vector<Segment> pending_segments_;
+    std::vector<char> inline_data_;                         // 拷贝的短片段依次拼接
+    std::vector<std::pair<size_t, size_t>> pending_frames_; // 每帧在 pending_segments_ 中的 (起点, 片段数)
+    int64_t pending_since_us_ = 0;                          // 最早一帧的排队时间
+    std::vector<struct iovec> iov_;
+    std::vector<struct mmsghdr> messages_;
+    uint64_t sent_messages_ = 0;
+    uint64_t send_errors_ = 0;
+    uint64_t send_calls_ = 0;
+};
@@ -0,0 +1,349 @@
+#include "track_kinematics.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double kSecondsPerDay = 86400.0;
+
+const char* const kRollingFeatureNames[kRollingFeatureDim] = {
+    "speed_mean", "speed_std", "speed_ewma_std", "turn_rate", "turn_rate_std",
+    "acc_mean", "acc_max", "rcs_mean", "rcs_std", "rcs_range", "snr_std", "snr_range",
+    "samples",
+};
+
+float UnwrapDelta(float delta) {
+    return delta - 360.0f * std::round(delta / 360.0f);
+}
+
+float SampleStd(float count, float m2) {
+    return count > 1.0f ? std::sqrt(std::max(m2, 0.0f) / (count - 1.0f)) : 0.0f;
+}
+
+// 对 n 个样本各自的统计状态做一次无分支更新, 循环可被编译器向量化:
+// reset 为 1 时先把旧状态清零; needs_previous 为 1 时 reset 样本本身不计入(如转弯率需要前一个点);
+// EWMA 系数取 max(alpha, 1/n), 起始阶段等价于算术平均, 不偏向初值 0
+// (max 写成 (a + b + |a - b|) / 2, 比较运算在默认浮点语义下会阻止向量化)
+void UpdateMoments(size_t n, const float* x, const float* reset, float needs_previous,
+                   float alpha, float* __restrict count, float* __restrict mean,
+                   float* __restrict m2, float* __restrict ewma, float* __restrict ewvar) {
+    for (size_t i = 0; i < n; ++i) {
+        const float keep = 1.0f - reset[i];
+        const float w = 1.0f - needs_previous * reset[i];
+        const float k = count[i] * keep + w;
+        const float inv = w / (k + 1.0f - w);   // w 为 0 时 k 可能为 0, 分母至少为 1
+
+        // Welford
+        float mu = mean[i] * keep;
+        const float d = x[i] - mu;
+        mu += d * inv;
+        m2[i] = m2[i] * keep + w * d * (x[i] - mu);
+        mean[i] = mu;
+        count[i] = k;
+
+        // EWMA 均值与方差
+        const float aw = alpha * w;
+        const float a = 0.5f * (aw + inv + std::fabs(aw - inv));
+        const float e = ewma[i] * keep;
+        const float ed = x[i] - e;
+        const float incr = a * ed;
+        ewma[i] = e + incr;
+        ewvar[i] = (1.0f - a) * (ewvar[i] * keep + ed * incr);
+    }
+}
+
+}  // namespace
+
+const RollingFeatureEngine::ExtremumSpec RollingFeatureEngine::kExtremumSpecs[kExtrema] = {
+    {kChAcc, true},
+    {kChRcs, false},
+    {kChRcs, true},
+    {kChSnr, false},
+    {kChSnr, true},
+};
+
+const char* RollingFeatureName(int feature) {
+    return feature >= 0 && feature < kRollingFeatureDim ? kRollingFeatureNames[feature] : "unknown";
+}
+
+RollingFeatureEngine::RollingFeatureEngine(const RollingFeatureConfig& config)
+    : config_(config) {
+    config_.ewma_alpha = std::min(std::max(config_.ewma_alpha, 0.001f), 1.0f);
+    config_.window = std::min<size_t>(std::max<size_t>(config_.window, 1), 4096);
+}
+
+uint32_t RollingFeatureEngine::AcquireSlot(TrackKey track_key) {
+    auto it = slot_of_.find(track_key);
+    if (it != slot_of_.end()) {
+        return it->second;
+    }
+
+    uint32_t slot;
+    if (!free_slots_.empty()) {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        slot = slot_count_++;
+        last_time_.resize(slot_count_);
+        day_offset_.resize(slot_count_);
+        last_course_.resize(slot_count_);
+        seq_.resize(slot_count_);
+        staged_.resize(slot_count_);
+        for (int c = 0; c < kChannels; ++c) {
+            count_[c].resize(slot_count_);
+            mean_[c].resize(slot_count_);
+            m2_[c].resize(slot_count_);
+            ewma_[c].resize(slot_count_);
+            ewvar_[c].resize(slot_count_);
+        }
+        ext_value_.resize(slot_count_ * kExtrema * config_.window);
+        ext_seq_.resize(slot_count_ * kExtrema * config_.window);
+        ext_head_.resize(slot_count_ * kExtrema);
+        ext_size_.resize(slot_count_ * kExtrema);
+    }
+    ResetSlot(slot);
+    slot_of_.emplace(track_key, slot);
+    return slot;
+}
+
+void RollingFeatureEngine::ResetSlot(uint32_t slot) {
+    last_time_[slot] = -1.0;
+    day_offset_[slot] = 0.0;
+    last_course_[slot] = 0.0f;
+    seq_[slot] = 0;
+    staged_[slot] = 0;
+    for (int c = 0; c < kChannels; ++c) {
+        count_[c][slot] = 0.0f;
+        mean_[c][slot] = 0.0f;
+        m2_[c][slot] = 0.0f;
+        ewma_[c][slot] = 0.0f;
+        ewvar_[c][slot] = 0.0f;
+    }
+    for (int e = 0; e < kExtrema; ++e) {
+        ext_head_[slot * kExtrema + e] = 0;
+        ext_size_[slot * kExtrema + e] = 0;
+    }
+}
+
+void RollingFeatureEngine::UpdateFrame(const OcdHead_t& header, const NetTrackItem_t* items,
+                                       size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const NetTrackItem_t& item = items[i];
+        TrackKey key = MakeTrackKey(header, item);
+        if (item.status == 0) {
+            // 目标丢失
+            RemoveTrack(key);
+            continue;
+        }
+        if (item.status > 2) {
+            continue;
+        }
+
+        uint32_t slot = AcquireSlot(key);
+        if (staged_[slot]) {
+            // 同一帧内出现两次, 先结算前一个样本
+            Flush();
+        }
+
+        // 北京时跨零点后时间回绕, 累加一天保证单调
+        double t = TrackTimeOfDay(header, item) + day_offset_[slot];
+        if (last_time_[slot] >= 0.0 && t < last_time_[slot] - kSecondsPerDay / 2) {
+            day_offset_[slot] += kSecondsPerDay;
+            t += kSecondsPerDay;
+        }
+        double dt = t - last_time_[slot];
+        if (last_time_[slot] >= 0.0 && dt <= 0.0) {
+            // 重复或乱序的点直接丢弃
+            continue;
+        }
+        const bool reset = last_time_[slot] < 0.0 || dt > config_.max_gap_sec;
+
+        float course = item.course * 0.1f;
+        float turn = reset ? 0.0f :
+            UnwrapDelta(course - last_course_[slot]) / static_cast<float>(dt);
+        last_time_[slot] = t;
+        last_course_[slot] = course;
+
+        stage_slot_.push_back(slot);
+        staged_[slot] = static_cast<uint32_t>(stage_slot_.size());
+        stage_reset_.push_back(reset ? 1.0f : 0.0f);
+        stage_value_[kChSpeed].push_back(item.speed * 0.1f);
+        stage_value_[kChTurn].push_back(turn);
+        stage_value_[kChAcc].push_back(item.acc * 0.01f);
+        stage_value_[kChRcs].push_back(item.rcs * 0.01f);
+        stage_value_[kChSnr].push_back(item.snr * 0.01f);
+    }
+    Flush();
+}
+
+void RollingFeatureEngine::Flush() {
+    const size_t n = stage_slot_.size();
+    if (n == 0) {
+        return;
+    }
+    lane_count_.resize(n);
+    lane_mean_.resize(n);
+    lane_m2_.resize(n);
+    lane_ewma_.resize(n);
+    lane_ewvar_.resize(n);
+    const uint32_t* slots = stage_slot_.data();
+    const float* reset = stage_reset_.data();
+
+    for (int c = 0; c < kChannels; ++c) {
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t s = slots[i];
+            lane_count_[i] = count_[c][s];
+            lane_mean_[i] = mean_[c][s];
+            lane_m2_[i] = m2_[c][s];
+            lane_ewma_[i] = ewma_[c][s];
+            lane_ewvar_[i] = ewvar_[c][s];
+        }
+
+        UpdateMoments(n, stage_value_[c].data(), reset, c == kChTurn ? 1.0f : 0.0f,
+                      config_.ewma_alpha, lane_count_.data(), lane_mean_.data(), lane_m2_.data(),
+                      lane_ewma_.data(), lane_ewvar_.data());
+
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t s = slots[i];
+            count_[c][s] = lane_count_[i];
+            mean_[c][s] = lane_mean_[i];
+            m2_[c][s] = lane_m2_[i];
+            ewma_[c][s] = lane_ewma_[i];
+            ewvar_[c][s] = lane_ewvar_[i];
+        }
+    }
+
+    // 滑动窗口极值: 单调队列逐条维护
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t s = slots[i];
+        if (reset[i] != 0.0f) {
+            for (int e = 0; e < kExtrema; ++e) {
+                ext_head_[s * kExtrema + e] = 0;
+                ext_size_[s * kExtrema + e] = 0;
+            }
+        }
+        seq_[s]++;
+        for (int e = 0; e < kExtrema; ++e) {
+            PushExtremum(s, e, stage_value_[kExtremumSpecs[e].channel][i]);
+        }
+        staged_[s] = 0;
+    }
+
+    stage_slot_.clear();
+    stage_reset_.clear();
+    for (int c = 0; c < kChannels; ++c) {
+        stage_value_[c].clear();
+    }
+}
+
+void RollingFeatureEngine::PushExtremum(uint32_t slot, int extremum, float value) {
+    const size_t window = config_.window;
+    const size_t index = slot * kExtrema + extremum;
+    const bool is_max = kExtremumSpecs[extremum].is_max;
+    float* values = &ext_value_[index * window];
+    uint32_t* seqs = &ext_seq_[index * window];
+    size_t head = ext_head_[index];
+    size_t size = ext_size_[index];
+    const uint32_t seq = seq_[slot];
+
+    // 队尾不如新值的元素永远不会再成为极值
+    while (size > 0) {
+        size_t back = head + size - 1;
+        float v = values[back < window ? back : back - window];
+        if (is_max ? v <= value : v >= value) {
+            --size;
+        } else {
+            break;
+        }
+    }
+    // 队首滑出窗口
+    while (size > 0 && seqs[head] + window <= seq) {
+        head = head + 1 < window ? head + 1 : 0;
+        --size;
+    }
+    size_t pos = head + size;
+    pos = pos < window ? pos : pos - window;
+    values[pos] = value;
+    seqs[pos] = seq;
+    ext_head_[index] = static_cast<uint16_t>(head);
+    ext_size_[index] = static_cast<uint16_t>(size + 1);
+}
+
+float RollingFeatureEngine::Extremum(uint32_t slot, int extremum) const {
+    const size_t index = slot * kExtrema + extremum;
+    return ext_size_[index] > 0 ? ext_value_[index * config_.window + ext_head_[index]] : 0.0f;
+}
+
+void RollingFeatureEngine::WriteFeatures(uint32_t slot, float* out) const {
+    out[kRollSpeedMean] = mean_[kChSpeed][slot];
+    out[kRollSpeedStd] = SampleStd(count_[kChSpeed][slot], m2_[kChSpeed][slot]);
+    out[kRollSpeedEwmaStd] = std::sqrt(std::max(ewvar_[kChSpeed][slot], 0.0f));
+    out[kRollTurnRate] = ewma_[kChTurn][slot];
+    out[kRollTurnRateStd] = std::sqrt(std::max(ewvar_[kChTurn][slot], 0.0f));
+    out[kRollAccMean] = ewma_[kChAcc][slot];
+    out[kRollAccMax] = Extremum(slot, kExtAccMax);
+    out[kRollRcsMean] = ewma_[kChRcs][slot];
+    out[kRollRcsStd] = SampleStd(count_[kChRcs][slot], m2_[kChRcs][slot]);
+    out[kRollRcsRange] = Extremum(slot, kExtRcsMax) - Extremum(slot, kExtRcsMin);
+    out[kRollSnrStd] = std::sqrt(std::max(ewvar_[kChSnr][slot], 0.0f));
+    out[kRollSnrRange] = Extremum(slot, kExtSnrMax) - Extremum(slot, kExtSnrMin);
+    out[kRollSamples] = count_[kChSpeed][slot];
+}
+
+void RollingFeatureEngine::RemoveTrack(TrackKey track_key) {
+    auto it = slot_of_.find(track_key);
+    if (it == slot_of_.end()) {
+        return;
+    }
+    if (staged_[it->second]) {
+        Flush();
+    }
+    free_slots_.push_back(it->second);
+    slot_of_.erase(it);
+}
+
+void RollingFeatureEngine::Clear() {
+    slot_of_.clear();
+    free_slots_.clear();
+    slot_count_ = 0;
+    last_time_.clear();
+    day_offset_.clear();
+    last_course_.clear();
+    seq_.clear();
+    staged_.clear();
+    for (int c = 0; c < kChannels; ++c) {
+        count_[c].clear();
+        mean_[c].clear();
+        m2_[c].clear();
+        ewma_[c].clear();
+        ewvar_[c].clear();
+        stage_value_[c].clear();
+    }
+    ext_value_.clear();
+    ext_seq_.clear();
+    ext_head_.clear();
+    ext_size_.clear();
+    stage_slot_.clear();
+    stage_reset_.clear();
+}
+
+void RollingFeatureEngine::Gather(const std::vector<TrackKey>& track_keys,
+                                  std::vector<float>* features) const {
+    features->assign(track_keys.size() * kRollingFeatureDim, 0.0f);
+    for (size_t i = 0; i < track_keys.size(); ++i) {
+        auto it = slot_of_.find(track_keys[i]);
+        if (it != slot_of_.end()) {
+            WriteFeatures(it->second, features->data() + i * kRollingFeatureDim);
+        }
+    }
+}
+
+bool RollingFeatureEngine::Features(TrackKey track_key, float* features) const {
+    auto it = slot_of_.find(track_key);
+    if (it == slot_of_.end()) {
+        return false;
+    }
+    WriteFeatures(it->second, features);
+    return true;
+}
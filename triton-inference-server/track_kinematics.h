@@ -0,0 +1,114 @@
+#pragma once
+
+// 航迹滚动运动学统计: 每个航迹点以常数时间更新速度方差、转弯率、RCS/信噪比起伏、加速度等统计量,
+// 不再对每个窗口从头重算; 可作为模型输入之外的附加特征列
+//
+// 状态按 SoA 布局存放在各航迹槽位中, 一帧的更新分三步:
+// 逐条解码并收集本帧样本 -> 对收集到的连续数组做无分支的 Welford/EWMA 更新(编译器可向量化)
+// -> 逐条维护滑动窗口最小/最大值的单调队列(均摊 O(1))
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "track_message.h"
+
+// 附加特征列顺序
+enum RollingFeature {
+    kRollSpeedMean = 0,     // 全速度均值 m/s (Welford, 航迹起始以来)
+    kRollSpeedStd,          // 全速度标准差 m/s (Welford)
+    kRollSpeedEwmaStd,      // 全速度近期标准差 m/s (EWMA)
+    kRollTurnRate,          // 转弯率 度/s, 由航向差分得到 (EWMA 均值)
+    kRollTurnRateStd,       // 转弯率近期标准差 度/s (EWMA), 反映左右摆动
+    kRollAccMean,           // 空间加速度近期均值 m/s^2 (EWMA)
+    kRollAccMax,            // 空间加速度滑动窗口最大值 m/s^2
+    kRollRcsMean,           // RCS 近期均值 dB (EWMA)
+    kRollRcsStd,            // RCS 标准差 dB (Welford)
+    kRollRcsRange,          // RCS 滑动窗口极差 dB
+    kRollSnrStd,            // 信噪比近期标准差 dB (EWMA)
+    kRollSnrRange,          // 信噪比滑动窗口极差 dB
+    kRollSamples,           // 参与统计的样本数
+};
+constexpr int kRollingFeatureDim = kRollSamples + 1;
+
+const char* RollingFeatureName(int feature);
+
+struct RollingFeatureConfig {
+    float ewma_alpha = 0.2f;        // EWMA 平滑系数, 约等于最近 1/alpha 个样本
+    size_t window = 16;             // 最小/最大值滑动窗口的样本数
+    double max_gap_sec = 5.0;       // 相邻样本间隔超过此值视为断批, 统计量清零
+};
+
+class RollingFeatureEngine {
+public:
+    explicit RollingFeatureEngine(const RollingFeatureConfig& config = RollingFeatureConfig());
+
+    // 写入一帧解码后的航迹: 状态 0 删除, 1/2 更新, 其余忽略
+    void UpdateFrame(const OcdHead_t& header, const NetTrackItem_t* items, size_t count);
+
+    void RemoveTrack(TrackKey track_key);
+    void Clear();
+
+    // 按 track_keys 顺序输出 [N, kRollingFeatureDim], 未知航迹输出全零
+    void Gather(const std::vector<TrackKey>& track_keys, std::vector<float>* features) const;
+    // 单条航迹的附加特征, 未知航迹返回 false
+    bool Features(TrackKey track_key, float* features) const;
+
+    size_t TrackCount() const { return slot_of_.size(); }
+    const RollingFeatureConfig& config() const { return config_; }
+
+private:
+    // 参与统计的原始量
+    enum Channel { kChSpeed = 0, kChTurn, kChAcc, kChRcs, kChSnr, kChannels };
+    // 维护滑动窗口极值的量: 加速度最大值, RCS/信噪比的最小和最大值
+    enum { kExtAccMax = 0, kExtRcsMin, kExtRcsMax, kExtSnrMin, kExtSnrMax, kExtrema };
+    struct ExtremumSpec {
+        Channel channel;
+        bool is_max;
+    };
+    static const ExtremumSpec kExtremumSpecs[kExtrema];
+
+    uint32_t AcquireSlot(TrackKey track_key);
+    void ResetSlot(uint32_t slot);
+    // 对已收集的样本执行 Welford/EWMA 和滑动极值更新, 然后清空收集区
+    void Flush();
+    void PushExtremum(uint32_t slot, int extremum, float value);
+    float Extremum(uint32_t slot, int extremum) const;
+    void WriteFeatures(uint32_t slot, float* out) const;
+
+    RollingFeatureConfig config_;
+    std::unordered_map<TrackKey, uint32_t> slot_of_;
+    std::vector<uint32_t> free_slots_;
+    uint32_t slot_count_ = 0;
+
+    // 每槽位的时间/航向与样本序号
+    std::vector<double> last_time_;
+    std::vector<double> day_offset_;
+    std::vector<float> last_course_;
+    std::vector<uint32_t> seq_;
+    std::vector<uint32_t> staged_;      // 槽位在收集区中的位置 + 1, 0 表示本轮未收集
+
+    // 每个原始量的统计状态, [通道][槽位]
+    std::vector<float> count_[kChannels];
+    std::vector<float> mean_[kChannels];    // Welford 均值
+    std::vector<float> m2_[kChannels];      // Welford 离差平方和
+    std::vector<float> ewma_[kChannels];
+    std::vector<float> ewvar_[kChannels];
+
+    // 单调队列, [(槽位 * kExtrema + 极值) * window + i]
+    std::vector<float> ext_value_;
+    std::vector<uint32_t> ext_seq_;
+    std::vector<uint16_t> ext_head_;    // [槽位 * kExtrema + 极值]
+    std::vector<uint16_t> ext_size_;
+
+    // 本帧收集区, 按样本连续存放
+    std::vector<uint32_t> stage_slot_;
+    std::vector<float> stage_reset_;                // 1 表示本样本前统计量清零
+    std::vector<float> stage_value_[kChannels];
+    std::vector<float> lane_count_;                 // 向量化更新用的临时数组
+    std::vector<float> lane_mean_;
+    std::vector<float> lane_m2_;
+    std::vector<float> lane_ewma_;
+    std::vector<float> lane_ewvar_;
+};
@@ -0,0 +1,392 @@
+#pragma once
+
+// 航迹报文(0x1010)线上格式定义, 供解码、窗口化和回写共用
+// 字段后的 [n] 为 16 位字序号(从帧头开始计数)
+// 结构体只是解码后的内存表示, 报文字节与结构体之间的转换由下方的字段描述在编译期生成,
+// 不依赖编译器位域布局和主机字节序; 报文字节序默认小端, 以 -DTRACK_WIRE_BIG_ENDIAN 编译时按大端处理
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "wire_codec.h"
+
+typedef uint8_t  uint8;
+typedef uint16_t uint16;
+typedef uint32_t uint32;
+typedef int16_t  int16;
+typedef int32_t  int32;
+
+#pragma pack(push, 1)
+
+// 单目标航迹
+typedef struct NetTrackItem
+{
+        //[13]
+        uint8 			status			: 4;    // 目标状态 "0-丢失 1-跟踪 2-记忆"
+        uint8 			working			: 4;    // 工作方式  0-工作 1-重演
+        uint8			netReport_5779	: 4;	//  5779目标上报
+        uint8			netReport_wrj	: 4;	//  无人机目标上报
+                                                //[14]
+        uint16          tgt_num;				// 批号信息	目标批号
+                                                //[15]
+        uint16          chan_num;				// 目标通道号
+                                                //[16]~[17]
+        uint32 			burst_num;				// 目标流水号
+                                                //[18]
+        uint16			trk_hits;				// 航迹历史
+                                                //[19]
+        uint16          iffProperty : 4;		// 敌我属性	0-敌 1-敌方同盟 2-我 3-我友方 4-中立 5-不明 6-未识别
+        uint16          tgt_type : 4;			// 航迹类型	0-水平 1-垂直 2-融合
+        uint16			tgt_quality : 4;		// 航迹质量	0-7
+        uint16			bak2 : 4;				// 备份
+                                                //[20]
+        uint16          fix_flag : 1;			// 固定目标：0-无效 1-有效
+        uint16          ghost_flag : 1;			// 仙波	0-无效 1-有效
+        uint16          slow_flag : 1;			// 慢速目标 	0-无效 1-有效
+        uint16          spare3 : 13;			// 备份
+                                                //[21]
+        uint16			spare4;					// 备份
+                                                //[22]~[23]
+        uint32 			date;					// 时间信息	基日
+                                                //[24]~[25]
+        uint32 			time;					// 时间	当日的北京时，无符号整形,量化单位25us
+                                                //[26~[27]]
+        uint32   		tgt_rng;				// 滤波位置信息	径向距离	无符号整形,量化单位0.1m
+                                                //[28]~[29]
+        uint32   		tgt_azi; 				// 方位	无符号整形,量化单位:0.00001度
+                                                //[30]~[31]
+        int32   		tgt_ele; 				// 俯仰	有符号整形,量化单位:0.00001度
+                                                //[32]~[33]
+        uint32   		dtc_rng; 				// 点迹位置信息	径向距离	无符号整形,量化单位0.1m
+                                                //[34]~[35]
+        uint32   		dtc_azi; 				// 方位	无符号整形,量化单位:0.00001度
+                                                //[36]~[37]
+        int32   		dtc_ele; 				// 俯仰	有符号整形,量化单位:0.00001度
+                                                //[38]~[39]
+        int32           radial_vel;				// 速度信息	径向速度	有符号整形，量化单位0.01m/s
+                                                //[40]
+        int16   		azi_vel;				// 方位速度	有符号整形，量化单位: 0.001度/s
+                                                //[41]
+        int16   		ele_vel;				// 俯仰速度	有符号整形，量化单位: 0.001度/s
+                                                //[42]~[43]
+        uint32   		speed;					// 全速度 无符号整形无符号整形,量化单位0.1m
+                                                //[44]
+        uint16          acc;					// 空间加速度 无符号整形，0.01米/秒秒
+                                                //[45]
+        uint16          course;					// 航向 无符号整形，0.1度
+                                                //[46]
+        int16 	 		rng_err_mean;			// 距离误差均值 有号整形,量化单位0.1m
+                                                //[47]
+        uint16          rng_err_std;			// 距离误差均方根	无符号整形,量化单位0.1m
+                                                //[48]
+        int16 	 		az_err_mean;			// 方位误差均值 有符号号整形,量化单位0.001度
+                                                //[49]
+        uint16          az_err_std;				// 方位误差均方根, 无符号整形,量化单位0.001度
+                                                //[50]
+        int16 	 		ele_err_mean;			// 俯仰误差均值		有号整形,量化单位0.001度
+                                                //[51]
+        uint16          ele_err_std;			// 俯仰误差均方根		无符号整形,量化单位0.001度
+                                                //[52]
+        uint16          amp;					// 幅度信息		无符号整形，量化单位0.1dB
+                                                //[53]
+        uint16          snr;					// 目标信噪比		无符号整形，量化单位: 0.01dB
+                                                //[54]
+        int16	 		rcs;					// RCS		有符号整形，量化单位: 0.01dB
+                                                //[55]
+        uint16			tgt_category : 8;		// 识别信息大类		1-鸟类, 2-空飘球，3-飞机，4-汽车，5-大鸟，6-小鸟，7-无人机，0xf-不明
+        uint16			tgt_species : 8;		// 识别信息小类
+                                                //[56]
+        uint16			tgt_threat : 8;			// 威胁度
+        uint16			task_stat : 8;			// 任务计划执行状态
+        uint32			plat_lon;			// [57-58] 站址信息 经度
+        uint32			plat_lat;			// [59-60] 站址信息 纬度
+        uint32			plat_alt;			// [61-62] 站址信息 高度
+        uint16			svo_yaw;			// [63] 伺服信息	天线方位	量化单位:0.005493247
+        uint16			svo_pitch;			// [64] 天线俯仰	量化单位:0.005493247
+        uint16			pluse_width;		// [65] 信号形式	脉宽
+        uint8			freq_ratio;			// [66] 调频斜率
+        uint8			work_band;			// [66] 带宽
+        uint32			disAirport;			// [67-68] 距离飞机跑到中心距离
+        uint16			tas_freq;			// [69] 跟踪频点
+        uint16			tas_prd;			// [70] 跟踪数据率 无符号整形,量化单位:0.001秒
+        uint32			tas_num;			// [71-72] 数据处理序列号
+        int32			tgtX;				// [73-74] 目标地心X,量化单位0.01
+        int32			tgtY;				// [75-76] 目标地心Y,量化单位0.01
+        int32			tgtZ;				// [77-78] 目标地心Z,量化单位0.01
+        int32			tgtVX;				// [79-80] 地心VX速度,量化单位0.01
+        int32			tgtVY;				// [81-82] 地心VY速度,量化单位0.01
+        int32			tgtVZ;				// [83-84] 地心VZ速度,量化单位0.01
+        uint32			threadDis;			// [85-86] 距离最近威胁区距离，单位0.1m
+        uint32			threadTime;			// [87-88] 距离最近威胁区时间，单位1s
+        uint16			bak3[4];			// [89-92]
+}NetTrackItem_t;
+
+
+typedef struct OcdHead {
+        enum {
+                HeadFlag = 0xA1A1
+        };
+
+        uint16 	msg_code;                   // [0] 报文头
+        uint16	majorCommand;				// [1] 命令类型大类
+        uint16	msg_len;                    // [2] 帧长, 包含帧头和尾
+        uint16 	msg_index;                  // [3] 帧序列号
+        uint16 	rdr_station_id;             // [4] 雷达站号
+        uint16 	rdr_id;                     // [5] 雷达号, 0-方位 1-俯仰 2-融合航迹
+                                            // [6-8] BCD码
+        uint8	year;
+        uint8	month;
+        uint8	day;
+        uint8	hour;
+        uint8	minute;
+        uint8	second;
+
+        uint16  millisecond25;				// [9] 量化单位25us
+                                            // [10] 唯一标识，只有在同步时有用
+                                            // 发送同步控制命令时为1，非同步控制命令（用户操控）为0
+        uint16	uniqueID;
+        uint16	spare;					// [11] 备份
+} OcdHead_t;
+
+#pragma pack(pop)
+
+static_assert(sizeof(OcdHead_t) == 12 * 2, "OcdHead_t 应为 12 个字");
+static_assert(sizeof(NetTrackItem_t) == (92 - 13 + 1) * 2, "NetTrackItem_t 应为 80 个字");
+
+// 航迹报文标识0x1010
+typedef struct NetTrackInfo
+{
+        OcdHead_t       header;             // 报文头
+        uint16          tgt_num;            // 本帧传送目
+        NetTrackItem    *track_item;		// 单航迹信息，不超过1000
+        uint16			check_sum;          // 校验和
+        uint16			msg_end;            // 帧尾
+}NetTrackInfo_t;
+
+// 航迹报文命令字
+constexpr uint16 kTrackFrameCommand = 0x1010;
+// 单帧最多航迹数
+constexpr size_t kMaxTracksPerFrame = 1000;
+// 帧头 + 目标数
+constexpr size_t kTrackFramePrefixSize = sizeof(OcdHead_t) + sizeof(uint16);
+// 校验和 + 帧尾
+constexpr size_t kTrackFrameSuffixSize = 2 * sizeof(uint16);
+
+#ifdef TRACK_WIRE_BIG_ENDIAN
+constexpr WireEndian kTrackWireEndian = WireEndian::kBig;
+#else
+constexpr WireEndian kTrackWireEndian = WireEndian::kLittle;
+#endif
+
+// 帧头字段, 偏移为 [n] * 2
+namespace head_wire {
+
+constexpr size_t WordOffset(size_t word) { return word * 2; }
+
+WIRE_MEMBER(MsgCode, OcdHead_t, msg_code, WordOffset(0), 2);
+WIRE_MEMBER(MajorCommand, OcdHead_t, majorCommand, WordOffset(1), 2);
+WIRE_MEMBER(MsgLen, OcdHead_t, msg_len, WordOffset(2), 2);
+WIRE_MEMBER(MsgIndex, OcdHead_t, msg_index, WordOffset(3), 2);
+WIRE_MEMBER(RdrStationId, OcdHead_t, rdr_station_id, WordOffset(4), 2);
+WIRE_MEMBER(RdrId, OcdHead_t, rdr_id, WordOffset(5), 2);
+WIRE_MEMBER(Year, OcdHead_t, year, WordOffset(6), 1);
+WIRE_MEMBER(Month, OcdHead_t, month, WordOffset(6) + 1, 1);
+WIRE_MEMBER(Day, OcdHead_t, day, WordOffset(7), 1);
+WIRE_MEMBER(Hour, OcdHead_t, hour, WordOffset(7) + 1, 1);
+WIRE_MEMBER(Minute, OcdHead_t, minute, WordOffset(8), 1);
+WIRE_MEMBER(Second, OcdHead_t, second, WordOffset(8) + 1, 1);
+WIRE_MEMBER(Millisecond25, OcdHead_t, millisecond25, WordOffset(9), 2);
+WIRE_MEMBER(UniqueId, OcdHead_t, uniqueID, WordOffset(10), 2);
+WIRE_MEMBER(Spare, OcdHead_t, spare, WordOffset(11), 2);
+// 帧头之后的本帧目标数
+using TgtNum = WireField<WordOffset(12), 2>;
+
+}  // namespace head_wire
+
+using OcdHeadSchema = WireSchema<
+    head_wire::MsgCode, head_wire::MajorCommand, head_wire::MsgLen, head_wire::MsgIndex,
+    head_wire::RdrStationId, head_wire::RdrId, head_wire::Year, head_wire::Month, head_wire::Day,
+    head_wire::Hour, head_wire::Minute, head_wire::Second, head_wire::Millisecond25,
+    head_wire::UniqueId, head_wire::Spare>;
+static_assert(OcdHeadSchema::Covers(sizeof(OcdHead_t)), "帧头字段描述应完整覆盖 OcdHead_t");
+
+// 单条航迹字段, 偏移为 ([n] - 13) * 2; 位域的位移按所在字的数值计算
+namespace item_wire {
+
+constexpr size_t WordOffset(size_t word) { return (word - 13) * 2; }
+
+WIRE_BITS(Status, NetTrackItem_t, status, WordOffset(13), 1, 0, 4);
+WIRE_BITS(Working, NetTrackItem_t, working, WordOffset(13), 1, 4, 4);
+WIRE_BITS(NetReport5779, NetTrackItem_t, netReport_5779, WordOffset(13) + 1, 1, 0, 4);
+WIRE_BITS(NetReportWrj, NetTrackItem_t, netReport_wrj, WordOffset(13) + 1, 1, 4, 4);
+WIRE_MEMBER(TgtNum, NetTrackItem_t, tgt_num, WordOffset(14), 2);
+WIRE_MEMBER(ChanNum, NetTrackItem_t, chan_num, WordOffset(15), 2);
+WIRE_MEMBER(BurstNum, NetTrackItem_t, burst_num, WordOffset(16), 4);
+WIRE_MEMBER(TrkHits, NetTrackItem_t, trk_hits, WordOffset(18), 2);
+WIRE_BITS(IffProperty, NetTrackItem_t, iffProperty, WordOffset(19), 2, 0, 4);
+WIRE_BITS(TgtType, NetTrackItem_t, tgt_type, WordOffset(19), 2, 4, 4);
+WIRE_BITS(TgtQuality, NetTrackItem_t, tgt_quality, WordOffset(19), 2, 8, 4);
+WIRE_BITS(Bak2, NetTrackItem_t, bak2, WordOffset(19), 2, 12, 4);
+WIRE_BITS(FixFlag, NetTrackItem_t, fix_flag, WordOffset(20), 2, 0, 1);
+WIRE_BITS(GhostFlag, NetTrackItem_t, ghost_flag, WordOffset(20), 2, 1, 1);
+WIRE_BITS(SlowFlag, NetTrackItem_t, slow_flag, WordOffset(20), 2, 2, 1);
+WIRE_BITS(Spare3, NetTrackItem_t, spare3, WordOffset(20), 2, 3, 13);
+WIRE_MEMBER(Spare4, NetTrackItem_t, spare4, WordOffset(21), 2);
+WIRE_MEMBER(Date, NetTrackItem_t, date, WordOffset(22), 4);
+WIRE_MEMBER(Time, NetTrackItem_t, time, WordOffset(24), 4);
+WIRE_MEMBER(TgtRng, NetTrackItem_t, tgt_rng, WordOffset(26), 4);
+WIRE_MEMBER(TgtAzi, NetTrackItem_t, tgt_azi, WordOffset(28), 4);
+WIRE_MEMBER(TgtEle, NetTrackItem_t, tgt_ele, WordOffset(30), 4);
+WIRE_MEMBER(DtcRng, NetTrackItem_t, dtc_rng, WordOffset(32), 4);
+WIRE_MEMBER(DtcAzi, NetTrackItem_t, dtc_azi, WordOffset(34), 4);
+WIRE_MEMBER(DtcEle, NetTrackItem_t, dtc_ele, WordOffset(36), 4);
+WIRE_MEMBER(RadialVel, NetTrackItem_t, radial_vel, WordOffset(38), 4);
+WIRE_MEMBER(AziVel, NetTrackItem_t, azi_vel, WordOffset(40), 2);
+WIRE_MEMBER(EleVel, NetTrackItem_t, ele_vel, WordOffset(41), 2);
+WIRE_MEMBER(Speed, NetTrackItem_t, speed, WordOffset(42), 4);
+WIRE_MEMBER(Acc, NetTrackItem_t, acc, WordOffset(44), 2);
+WIRE_MEMBER(Course, NetTrackItem_t, course, WordOffset(45), 2);
+WIRE_MEMBER(RngErrMean, NetTrackItem_t, rng_err_mean, WordOffset(46), 2);
+WIRE_MEMBER(RngErrStd, NetTrackItem_t, rng_err_std, WordOffset(47), 2);
+WIRE_MEMBER(AzErrMean, NetTrackItem_t, az_err_mean, WordOffset(48), 2);
+WIRE_MEMBER(AzErrStd, NetTrackItem_t, az_err_std, WordOffset(49), 2);
+WIRE_MEMBER(EleErrMean, NetTrackItem_t, ele_err_mean, WordOffset(50), 2);
+WIRE_MEMBER(EleErrStd, NetTrackItem_t, ele_err_std, WordOffset(51), 2);
+WIRE_MEMBER(Amp, NetTrackItem_t, amp, WordOffset(52), 2);
+WIRE_MEMBER(Snr, NetTrackItem_t, snr, WordOffset(53), 2);
+WIRE_MEMBER(Rcs, NetTrackItem_t, rcs, WordOffset(54), 2);
+WIRE_BITS(TgtCategory, NetTrackItem_t, tgt_category, WordOffset(55), 2, 0, 8);
+WIRE_BITS(TgtSpecies, NetTrackItem_t, tgt_species, WordOffset(55), 2, 8, 8);
+WIRE_BITS(TgtThreat, NetTrackItem_t, tgt_threat, WordOffset(56), 2, 0, 8);
+WIRE_BITS(TaskStat, NetTrackItem_t, task_stat, WordOffset(56), 2, 8, 8);
+WIRE_MEMBER(PlatLon, NetTrackItem_t, plat_lon, WordOffset(57), 4);
+WIRE_MEMBER(PlatLat, NetTrackItem_t, plat_lat, WordOffset(59), 4);
+WIRE_MEMBER(PlatAlt, NetTrackItem_t, plat_alt, WordOffset(61), 4);
+WIRE_MEMBER(SvoYaw, NetTrackItem_t, svo_yaw, WordOffset(63), 2);
+WIRE_MEMBER(SvoPitch, NetTrackItem_t, svo_pitch, WordOffset(64), 2);
+WIRE_MEMBER(PluseWidth, NetTrackItem_t, pluse_width, WordOffset(65), 2);
+WIRE_MEMBER(FreqRatio, NetTrackItem_t, freq_ratio, WordOffset(66), 1);
+WIRE_MEMBER(WorkBand, NetTrackItem_t, work_band, WordOffset(66) + 1, 1);
+WIRE_MEMBER(DisAirport, NetTrackItem_t, disAirport, WordOffset(67), 4);
+WIRE_MEMBER(TasFreq, NetTrackItem_t, tas_freq, WordOffset(69), 2);
+WIRE_MEMBER(TasPrd, NetTrackItem_t, tas_prd, WordOffset(70), 2);
+WIRE_MEMBER(TasNum, NetTrackItem_t, tas_num, WordOffset(71), 4);
+WIRE_MEMBER(TgtX, NetTrackItem_t, tgtX, WordOffset(73), 4);
+WIRE_MEMBER(TgtY, NetTrackItem_t, tgtY, WordOffset(75), 4);
+WIRE_MEMBER(TgtZ, NetTrackItem_t, tgtZ, WordOffset(77), 4);
+WIRE_MEMBER(TgtVX, NetTrackItem_t, tgtVX, WordOffset(79), 4);
+WIRE_MEMBER(TgtVY, NetTrackItem_t, tgtVY, WordOffset(81), 4);
+WIRE_MEMBER(TgtVZ, NetTrackItem_t, tgtVZ, WordOffset(83), 4);
+WIRE_MEMBER(ThreadDis, NetTrackItem_t, threadDis, WordOffset(85), 4);
+WIRE_MEMBER(ThreadTime, NetTrackItem_t, threadTime, WordOffset(87), 4);
+WIRE_MEMBER(Bak3_0, NetTrackItem_t, bak3[0], WordOffset(89), 2);
+WIRE_MEMBER(Bak3_1, NetTrackItem_t, bak3[1], WordOffset(90), 2);
+WIRE_MEMBER(Bak3_2, NetTrackItem_t, bak3[2], WordOffset(91), 2);
+WIRE_MEMBER(Bak3_3, NetTrackItem_t, bak3[3], WordOffset(92), 2);
+
+}  // namespace item_wire
+
+// 完整航迹
+using TrackItemSchema = WireSchema<
+    item_wire::Status, item_wire::Working, item_wire::NetReport5779, item_wire::NetReportWrj,
+    item_wire::TgtNum, item_wire::ChanNum, item_wire::BurstNum, item_wire::TrkHits,
+    item_wire::IffProperty, item_wire::TgtType, item_wire::TgtQuality, item_wire::Bak2,
+    item_wire::FixFlag, item_wire::GhostFlag, item_wire::SlowFlag, item_wire::Spare3,
+    item_wire::Spare4, item_wire::Date, item_wire::Time,
+    item_wire::TgtRng, item_wire::TgtAzi, item_wire::TgtEle,
+    item_wire::DtcRng, item_wire::DtcAzi, item_wire::DtcEle,
+    item_wire::RadialVel, item_wire::AziVel, item_wire::EleVel, item_wire::Speed,
+    item_wire::Acc, item_wire::Course,
+    item_wire::RngErrMean, item_wire::RngErrStd, item_wire::AzErrMean, item_wire::AzErrStd,
+    item_wire::EleErrMean, item_wire::EleErrStd, item_wire::Amp, item_wire::Snr, item_wire::Rcs,
+    item_wire::TgtCategory, item_wire::TgtSpecies, item_wire::TgtThreat, item_wire::TaskStat,
+    item_wire::PlatLon, item_wire::PlatLat, item_wire::PlatAlt, item_wire::SvoYaw, item_wire::SvoPitch,
+    item_wire::PluseWidth, item_wire::FreqRatio, item_wire::WorkBand, item_wire::DisAirport,
+    item_wire::TasFreq, item_wire::TasPrd, item_wire::TasNum,
+    item_wire::TgtX, item_wire::TgtY, item_wire::TgtZ, item_wire::TgtVX, item_wire::TgtVY, item_wire::TgtVZ,
+    item_wire::ThreadDis, item_wire::ThreadTime,
+    item_wire::Bak3_0, item_wire::Bak3_1, item_wire::Bak3_2, item_wire::Bak3_3>;
+static_assert(TrackItemSchema::Covers(sizeof(NetTrackItem_t)), "航迹字段描述应完整覆盖 NetTrackItem_t");
+
+// 分类流水线用到的字段: 状态、批号、时间、14 个窗口特征、数据率, 回写时沿用的识别小类,
+// 以及跨雷达关联用的地心坐标和速度; 滚动运动学统计用到的字段也都在其中
+using TrackFeatureSchema = WireSchema<
+    item_wire::Status, item_wire::TgtNum, item_wire::Time,
+    item_wire::TgtRng, item_wire::TgtAzi, item_wire::TgtEle, item_wire::RadialVel,
+    item_wire::AziVel, item_wire::EleVel, item_wire::Speed, item_wire::Acc, item_wire::Course,
+    item_wire::AzErrStd, item_wire::EleErrStd, item_wire::Amp, item_wire::Snr, item_wire::Rcs,
+    item_wire::TgtSpecies, item_wire::TasPrd,
+    item_wire::TgtX, item_wire::TgtY, item_wire::TgtZ,
+    item_wire::TgtVX, item_wire::TgtVY, item_wire::TgtVZ>;
+static_assert(TrackFeatureSchema::Ordered(), "特征字段应按线上顺序排列");
+
+// 第 index 条航迹在帧内的字节偏移
+inline size_t TrackItemOffset(size_t index) {
+    return kTrackFramePrefixSize + index * sizeof(NetTrackItem_t);
+}
+
+// 包含 tgt_num 条航迹的完整帧长度(字节)
+inline size_t TrackFrameSize(size_t tgt_num) {
+    return TrackItemOffset(tgt_num) + kTrackFrameSuffixSize;
+}
+
+// 解析帧头和目标数, 检查长度是否足够容纳全部航迹
+inline bool ParseTrackFrameHeader(const char* data, size_t size,
+                                  OcdHead_t* header, uint16* tgt_num) {
+    if (size < TrackFrameSize(1)) {
+        return false;
+    }
+    OcdHeadSchema::Decode<kTrackWireEndian>(data, header);
+    *tgt_num = head_wire::TgtNum::Read<kTrackWireEndian>(data);
+    if (*tgt_num == 0 || *tgt_num > kMaxTracksPerFrame) {
+        return false;
+    }
+    return size >= TrackFrameSize(*tgt_num);
+}
+
+// 读取第 index 条航迹; Schema 只含部分字段时 item 的其他字段保持原值
+template <typename Schema = TrackItemSchema>
+inline void ReadTrackItem(const char* data, size_t index, NetTrackItem_t* item) {
+    Schema::template Decode<kTrackWireEndian>(data + TrackItemOffset(index), item);
+}
+
+// 写入帧头和目标数, data 至少为 kTrackFramePrefixSize 字节
+inline void WriteTrackFrameHeader(char* data, const OcdHead_t& header, uint16 tgt_num) {
+    OcdHeadSchema::Encode<kTrackWireEndian>(header, data);
+    head_wire::TgtNum::Write<kTrackWireEndian>(data, tgt_num);
+}
+
+// 写入第 index 条航迹
+inline void WriteTrackItem(char* data, size_t index, const NetTrackItem_t& item) {
+    TrackItemSchema::Encode<kTrackWireEndian>(item, data + TrackItemOffset(index));
+}
+
+// 航迹唯一键: 雷达站号 + 雷达号 + 批号; 同一站的方位/俯仰/融合航迹批号各自编排, 可能重复
+using TrackKey = uint64_t;
+
+inline TrackKey MakeTrackKey(uint16 station_id, uint16 rdr_id, uint16 tgt_num) {
+    return (static_cast<TrackKey>(station_id) << 32) | (static_cast<TrackKey>(rdr_id) << 16) | tgt_num;
+}
+
+inline TrackKey MakeTrackKey(const OcdHead_t& header, const NetTrackItem_t& item) {
+    return MakeTrackKey(header.rdr_station_id, header.rdr_id, item.tgt_num);
+}
+
+inline int BcdToInt(uint8 bcd) {
+    return (bcd >> 4) * 10 + (bcd & 0x0F);
+}
+
+// 帧头时间(当日秒), 时分秒为BCD码, millisecond25 量化单位25us
+inline double FrameTimeOfDay(const OcdHead_t& header) {
+    return BcdToInt(header.hour) * 3600.0 + BcdToInt(header.minute) * 60.0 +
+           BcdToInt(header.second) + header.millisecond25 * 25e-6;
+}
+
+// 航迹点时间(当日秒), 优先使用航迹自带时间, 缺失时退回帧头时间
+inline double TrackTimeOfDay(const OcdHead_t& header, const NetTrackItem_t& item) {
+    if (item.time != 0) {
+        return item.time * 25e-6;
+    }
+    return FrameTimeOfDay(header);
+}
@@ -0,0 +1,747 @@
+#include "track_pipeline.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "trace_recorder.h"
+
+namespace {
+
+const char* kStageNames[kStageCount] = {"ingest", "decode", "window", "infer", "publish"};
+// 单条航迹时间线上各阶段之前的排队区间
+const char* kWaitNames[kStageCount] = {"", "wait.decode", "wait.window", "wait.infer", "wait.publish"};
+// 航迹时间线的行号 = 基数 + 航迹键, 与线程行号错开
+constexpr uint64_t kTraceTrackRow = 1000000;
+
+int64_t ElapsedNs(PipelineClock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        PipelineClock::now() - start).count();
+}
+
+void UpdateMax(std::atomic<uint64_t>* target, uint64_t value) {
+    uint64_t current = target->load(std::memory_order_relaxed);
+    while (value > current &&
+           !target->compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+int64_t NowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        PipelineClock::now().time_since_epoch()).count();
+}
+
+double Percentile(std::vector<double> values, double q) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t k = static_cast<size_t>(q * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+}  // namespace
+
+const char* PipelineStageName(int stage) {
+    return (stage >= 0 && stage < kStageCount) ? kStageNames[stage] : "unknown";
+}
+
+TrackPipeline::TrackPipeline(const PipelineConfig& config, InferFn infer, PublishFn publish,
+                             PublishIdleFn publish_idle)
+    : config_(config),
+      infer_(std::move(infer)),
+      publish_(std::move(publish)),
+      publish_idle_(std::move(publish_idle)),
+      recycle_(config.batch_pool_size),
+      window_store_(config.window),
+      rolling_(config.rolling),
+      associator_(config.association),
+      controller_(config.batching) {
+    config_.max_infer_batch = std::max<size_t>(config_.max_infer_batch, 1);
+    for (size_t i = 0; i < config_.batch_pool_size; ++i) {
+        pool_.emplace_back(new TrackBatch());
+    }
+    for (int i = 0; i + 1 < kStageCount; ++i) {
+        queues_.emplace_back(new BatchQueue(config_.queue_capacity));
+    }
+    for (auto& finished : finished_) {
+        finished.store(false);
+    }
+}
+
+TrackPipeline::~TrackPipeline() {
+    Wait();
+}
+
+void TrackPipeline::Start(FrameSource source) {
+    start_time_ = PipelineClock::now();
+    threads_.emplace_back(&TrackPipeline::RunIngest, this, std::move(source));
+    threads_.emplace_back(&TrackPipeline::RunDecode, this);
+    threads_.emplace_back(&TrackPipeline::RunWindow, this);
+    threads_.emplace_back(&TrackPipeline::RunInfer, this);
+    threads_.emplace_back(&TrackPipeline::RunPublish, this);
+}
+
+void TrackPipeline::Wait() {
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+}
+
+void TrackPipeline::PinStage(int stage) const {
+    if (TraceRecorder::Enabled()) {
+        TraceRecorder::Instance().SetThreadName(std::string("pipeline.") + PipelineStageName(stage));
+    }
+    if (stage >= static_cast<int>(config_.stage_cpus.size()) || config_.stage_cpus[stage] < 0) {
+        return;
+    }
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(config_.stage_cpus[stage], &cpuset);
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    if (ret != 0) {
+        std::cerr << "⚠️  阶段 " << PipelineStageName(stage) << " 绑定CPU "
+                  << config_.stage_cpus[stage] << " 失败: " << ret << std::endl;
+    }
+}
+
+bool TrackPipeline::PopInput(int stage, TrackBatch** batch) {
+    BatchQueue& in = *queues_[stage - 1];
+    StageCounters& counters = counters_[stage];
+    while (true) {
+        size_t occupancy = in.Size();
+        if (in.TryPop(batch)) {
+            counters.occupancy_sum.fetch_add(occupancy, std::memory_order_relaxed);
+            UpdateMax(&counters.occupancy_max, occupancy);
+            return true;
+        }
+        if (finished_[stage - 1].load(std::memory_order_acquire)) {
+            // 上游结束标志在最后一次推送之后设置, 再检查一次队列
+            return in.TryPop(batch);
+        }
+        counters.starved.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::yield();
+    }
+}
+
+bool TrackPipeline::TryPopInput(int stage, TrackBatch** batch, bool* upstream_done) {
+    BatchQueue& in = *queues_[stage - 1];
+    StageCounters& counters = counters_[stage];
+    // 先读结束标志再取, 标志为真且取不到才说明上游确实已排空
+    *upstream_done = finished_[stage - 1].load(std::memory_order_acquire);
+    size_t occupancy = in.Size();
+    if (!in.TryPop(batch)) {
+        return false;
+    }
+    counters.occupancy_sum.fetch_add(occupancy, std::memory_order_relaxed);
+    UpdateMax(&counters.occupancy_max, occupancy);
+    return true;
+}
+
+void TrackPipeline::PushOutput(int stage, TrackBatch* batch) {
+    BatchQueue& out = *queues_[stage];
+    while (!out.TryPush(batch)) {
+        counters_[stage].backpressure.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::yield();
+    }
+}
+
+bool TrackPipeline::CallInfer(uint64_t batch_id, const float* input, size_t count,
+                              std::vector<float>* output) {
+    if (!TraceRecorder::Enabled()) {
+        return infer_(input, count, output);
+    }
+    TraceRecorder::SetContextBatch(batch_id);
+    auto begin = PipelineClock::now();
+    bool ok = infer_(input, count, output);
+    TraceArgs args;
+    args.batch = static_cast<int64_t>(batch_id);
+    args.value_name = "batch_size";
+    args.value = static_cast<double>(count);
+    TraceRecorder::Instance().Complete("infer.request", "infer", begin, PipelineClock::now(), args);
+    return ok;
+}
+
+void TrackPipeline::TraceStage(int stage, TrackBatch* batch, PipelineClock::time_point begin) {
+    batch->stage_begin[stage] = begin;
+    batch->stage_end[stage] = PipelineClock::now();
+    TraceArgs args;
+    args.frame = static_cast<int64_t>(batch->sequence);
+    args.value_name = "tracks";
+    args.value = static_cast<double>(stage <= kStageDecode ? batch->items.size() : batch->track_keys.size());
+    if (stage > kStageDecode) {
+        args.msg_index = batch->header.msg_index;
+    }
+    TraceRecorder::Instance().Complete(PipelineStageName(stage), "stage", begin,
+                                       batch->stage_end[stage], args);
+}
+
+void TrackPipeline::TraceTrackJourneys(const TrackBatch& batch) {
+    TraceRecorder& trace = TraceRecorder::Instance();
+    for (size_t i = 0; i < batch.track_keys.size(); ++i) {
+        const TrackKey key = batch.track_keys[i];
+        if (!trace.SampleTrack(key)) {
+            continue;
+        }
+        const uint64_t row = kTraceTrackRow + key;
+        if (traced_tracks_.insert(key).second) {
+            trace.SetRowName(row, "track " + std::to_string(key >> 32) + "/" +
+                                  std::to_string((key >> 16) & 0xFFFF) + "/" +
+                                  std::to_string(key & 0xFFFF));
+        }
+        TraceArgs args;
+        args.track = key;
+        args.msg_index = batch.header.msg_index;
+        args.frame = static_cast<int64_t>(batch.sequence);
+        if (batch.infer_batch_size > 0) {
+            args.batch = static_cast<int64_t>(batch.infer_batch +
+                                              (batch.infer_window + i) / batch.infer_batch_size);
+        }
+        for (int stage = 0; stage < kStageCount; ++stage) {
+            if (stage > 0) {
+                trace.Complete(kWaitNames[stage], "wait", batch.stage_end[stage - 1],
+                               batch.stage_begin[stage], args, row);
+            }
+            trace.Complete(PipelineStageName(stage), "stage", batch.stage_begin[stage],
+                           batch.stage_end[stage], args, row);
+        }
+    }
+}
+
+void TrackPipeline::RunIngest(FrameSource source) {
+    PinStage(kStageIngest);
+    StageCounters& counters = counters_[kStageIngest];
+
+    // 空闲句柄: 先用预分配的, 用完后等待发布阶段归还
+    std::vector<TrackBatch*> free_batches;
+    for (auto& batch : pool_) {
+        free_batches.push_back(batch.get());
+    }
+
+    uint64_t sequence = 0;
+    while (true) {
+        TrackBatch* batch = nullptr;
+        if (!free_batches.empty()) {
+            batch = free_batches.back();
+            free_batches.pop_back();
+        } else {
+            while (!recycle_.TryPop(&batch)) {
+                // 在途批次已达上限
+                counters.backpressure.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::yield();
+            }
+        }
+
+        const bool tracing = TraceRecorder::Enabled();
+        PipelineClock::time_point receive;
+        if (tracing) {
+            receive = PipelineClock::now();
+        }
+        if (!source(&batch->frame)) {
+            break;
+        }
+        auto begin = PipelineClock::now();
+        batch->arrival = begin;
+        batch->sequence = sequence++;
+        batch->ok = true;
+        batch->infer_batch_size = 0;
+        if (tracing) {
+            // 接收区间包含等待数据源的时间
+            TraceStage(kStageIngest, batch, receive);
+        }
+        PushOutput(kStageIngest, batch);
+        counters.processed.fetch_add(1, std::memory_order_relaxed);
+        counters.busy_ns.fetch_add(ElapsedNs(begin), std::memory_order_relaxed);
+    }
+    finished_[kStageIngest].store(true, std::memory_order_release);
+}
+
+void TrackPipeline::RunDecode() {
+    PinStage(kStageDecode);
+    StageCounters& counters = counters_[kStageDecode];
+    TrackBatch* batch;
+    while (PopInput(kStageDecode, &batch)) {
+        auto begin = PipelineClock::now();
+        uint16 tgt_num = 0;
+        batch->items.clear();
+        if (ParseTrackFrameHeader(batch->frame.data(), batch->frame.size(),
+                                  &batch->header, &tgt_num)) {
+            batch->items.resize(tgt_num);
+            // 只解码后续阶段用到的字段, 不触及其余字节
+            for (uint16 i = 0; i < tgt_num; ++i) {
+                ReadTrackItem<TrackFeatureSchema>(batch->frame.data(), i, &batch->items[i]);
+            }
+        } else {
+            batch->ok = false;
+        }
+        if (TraceRecorder::Enabled()) {
+            TraceStage(kStageDecode, batch, begin);
+        }
+        counters.busy_ns.fetch_add(ElapsedNs(begin), std::memory_order_relaxed);
+        PushOutput(kStageDecode, batch);
+        counters.processed.fetch_add(1, std::memory_order_relaxed);
+    }
+    finished_[kStageDecode].store(true, std::memory_order_release);
+}
+
+void TrackPipeline::RunWindow() {
+    PinStage(kStageWindow);
+    StageCounters& counters = counters_[kStageWindow];
+    TrackBatch* batch;
+    while (PopInput(kStageWindow, &batch)) {
+        auto begin = PipelineClock::now();
+        frame_index_.clear();
+        batch->removed_keys.clear();
+        for (size_t i = 0; i < batch->items.size(); ++i) {
+            const NetTrackItem_t& item = batch->items[i];
+            // 状态 0 删除航迹, 1/2 保存, 其他值不处理
+            if (item.status <= 2) {
+                window_store_.AddTrackItem(batch->header, item);
+                const TrackKey key = MakeTrackKey(batch->header, item);
+                frame_index_[key] = static_cast<int>(i);
+                if (item.status == 0 && (config_.associate_tracks || TraceRecorder::Enabled())) {
+                    batch->removed_keys.push_back(key);
+                }
+            }
+        }
+        if (config_.rolling_features) {
+            rolling_.UpdateFrame(batch->header, batch->items.data(), batch->items.size());
+        }
+        batch->fanout_keys.clear();
+        batch->fanout_reps.clear();
+        size_t n;
+        if (config_.associate_tracks) {
+            // 先关联再选窗口, 归入其他代表的航迹只保留历史, 不输出窗口
+            associator_.UpdateFrame(batch->header, batch->items.data(), batch->items.size());
+            n = window_store_.PlanReadyWindows(
+                &batch->track_keys,
+                [this](TrackKey key) { return associator_.IsSuppressed(key); },
+                &batch->fanout_keys);
+            for (TrackKey key : batch->fanout_keys) {
+                batch->fanout_reps.push_back(associator_.RepresentativeOf(key));
+            }
+        } else {
+            n = window_store_.PlanReadyWindows(&batch->track_keys);
+        }
+        // 记下各航迹的帧内序号, 发布阶段只需遍历有标签的航迹
+        auto item_of = [this](TrackKey key) {
+            auto it = frame_index_.find(key);
+            return it != frame_index_.end() ? it->second : -1;
+        };
+        batch->track_items.clear();
+        for (TrackKey key : batch->track_keys) {
+            batch->track_items.push_back(item_of(key));
+        }
+        batch->fanout_items.clear();
+        for (TrackKey key : batch->fanout_keys) {
+            batch->fanout_items.push_back(item_of(key));
+        }
+        if (config_.rolling_features) {
+            rolling_.Gather(batch->track_keys, &batch->extra_features);
+        }
+        uint32_t slot;
+        if (config_.arena && n > 0 && n <= config_.arena->slot_windows() &&
+            config_.arena->Acquire(&slot)) {
+            batch->arena_slot = static_cast<int>(slot);
+            batch->window_data = config_.arena->InputPtr(slot);
+        } else {
+            batch->windows.resize(n * kWindowSteps * kFeatureDim);
+            batch->window_data = batch->windows.data();
+        }
+        window_store_.ResampleReadyWindows(batch->window_data);
+        if (TraceRecorder::Enabled()) {
+            TraceStage(kStageWindow, batch, begin);
+        }
+        counters.busy_ns.fetch_add(ElapsedNs(begin), std::memory_order_relaxed);
+        PushOutput(kStageWindow, batch);
+        counters.processed.fetch_add(1, std::memory_order_relaxed);
+    }
+    finished_[kStageWindow].store(true, std::memory_order_release);
+}
+
+void TrackPipeline::RunInfer() {
+    PinStage(kStageInfer);
+    if (config_.adaptive_batching) {
+        RunAdaptiveInfer();
+        return;
+    }
+    StageCounters& counters = counters_[kStageInfer];
+    const size_t window_size = kWindowSteps * kFeatureDim;
+    std::vector<float> output;
+    TrackBatch* batch;
+    while (PopInput(kStageInfer, &batch)) {
+        auto begin = PipelineClock::now();
+        batch->logits.clear();
+        const size_t total = batch->track_keys.size();
+        // 按模型最大批大小切分
+        batch->infer_batch = next_infer_batch_;
+        batch->infer_window = 0;
+        batch->infer_batch_size = static_cast<uint32_t>(config_.max_infer_batch);
+        for (size_t offset = 0; offset < total && batch->ok; offset += config_.max_infer_batch) {
+            size_t count = std::min(config_.max_infer_batch, total - offset);
+            if (!CallInfer(next_infer_batch_++, batch->window_data + offset * window_size, count,
+                           &output)) {
+                batch->ok = false;
+                break;
+            }
+            batch->logits.insert(batch->logits.end(), output.begin(), output.end());
+        }
+        if (TraceRecorder::Enabled()) {
+            TraceStage(kStageInfer, batch, begin);
+        }
+        counters.busy_ns.fetch_add(ElapsedNs(begin), std::memory_order_relaxed);
+        PushOutput(kStageInfer, batch);
+        counters.processed.fetch_add(1, std::memory_order_relaxed);
+    }
+    finished_[kStageInfer].store(true, std::memory_order_release);
+}
+
+void TrackPipeline::RunAdaptiveInfer() {
+    StageCounters& counters = counters_[kStageInfer];
+    uint32_t slot;
+    if (config_.arena && config_.arena->Acquire(&slot)) {
+        staging_slot_ = static_cast<int>(slot);
+    }
+    std::deque<TrackBatch*> pending;
+    size_t pending_windows = 0;
+    while (true) {
+        TrackBatch* batch;
+        bool upstream_done = false;
+        bool got = TryPopInput(kStageInfer, &batch, &upstream_done);
+        if (got) {
+            batch->logits.clear();
+            pending.push_back(batch);
+            pending_windows += batch->track_keys.size();
+        }
+
+        if (!pending.empty()) {
+            // 攒够一批、最早的帧等待超时或上游已结束时下发
+            int64_t waited_us = ElapsedNs(pending.front()->arrival) / 1000;
+            if (pending_windows >= static_cast<size_t>(controller_.batch_size()) ||
+                waited_us >= controller_.delay_us() || (upstream_done && !got)) {
+                DispatchPending(&pending);
+                pending_windows = 0;
+                continue;
+            }
+        } else if (upstream_done && !got) {
+            break;
+        }
+
+        if (!got) {
+            counters.starved.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::yield();
+        }
+    }
+    if (staging_slot_ >= 0) {
+        config_.arena->Release(static_cast<uint32_t>(staging_slot_));
+        staging_slot_ = -1;
+    }
+    finished_[kStageInfer].store(true, std::memory_order_release);
+}
+
+void TrackPipeline::DispatchPending(std::deque<TrackBatch*>* pending) {
+    StageCounters& counters = counters_[kStageInfer];
+    auto begin = PipelineClock::now();
+    const size_t window_size = kWindowSteps * kFeatureDim;
+
+    // 只有一帧时直接使用该帧的窗口缓冲, 否则拷贝到连续缓冲(放得下时用共享内存槽位)
+    const float* input;
+    size_t total = 0;
+    for (TrackBatch* batch : *pending) {
+        total += batch->track_keys.size();
+    }
+    if (pending->size() == 1) {
+        input = pending->front()->window_data;
+    } else {
+        float* dst;
+        if (staging_slot_ >= 0 && total <= config_.arena->slot_windows()) {
+            dst = config_.arena->InputPtr(static_cast<uint32_t>(staging_slot_));
+        } else {
+            staging_.resize(total * window_size);
+            dst = staging_.data();
+        }
+        input = dst;
+        for (TrackBatch* batch : *pending) {
+            size_t n = batch->track_keys.size() * window_size;
+            dst = std::copy(batch->window_data, batch->window_data + n, dst);
+        }
+    }
+
+    const size_t batch_size = std::min(static_cast<size_t>(controller_.batch_size()),
+                                       config_.max_infer_batch);
+    // 积压估计: 本次剩余窗口 + 输入队列中的帧 x 本次平均每帧窗口数
+    const size_t queued = queues_[kStageInfer - 1]->Size() * total / pending->size();
+    std::vector<float> output;
+    staged_logits_.clear();
+    bool ok = true;
+    const uint64_t first_batch = next_infer_batch_;
+    for (size_t offset = 0; offset < total; offset += batch_size) {
+        size_t count = std::min(batch_size, total - offset);
+        controller_.ObserveDispatch(static_cast<int>(count), total - offset - count + queued);
+        if (!CallInfer(next_infer_batch_++, input + offset * window_size, count, &output)) {
+            ok = false;
+            break;
+        }
+        staged_logits_.insert(staged_logits_.end(), output.begin(), output.end());
+    }
+
+    // 结果拆回各帧, 并以帧到达时间计算延迟反馈给控制器
+    const size_t num_classes = (ok && total > 0) ? staged_logits_.size() / total : 0;
+    const int64_t now_us = NowUs();
+    size_t offset = 0;
+    for (TrackBatch* batch : *pending) {
+        size_t n = batch->track_keys.size();
+        if (ok) {
+            auto first = staged_logits_.begin() + offset * num_classes;
+            batch->logits.assign(first, first + n * num_classes);
+            double latency_ms = ElapsedNs(batch->arrival) / 1e6;
+            for (size_t i = 0; i < n; ++i) {
+                controller_.ObserveLatency(now_us, latency_ms);
+            }
+        } else {
+            batch->ok = false;
+        }
+        batch->infer_batch = first_batch + offset / batch_size;
+        batch->infer_window = static_cast<uint32_t>(offset % batch_size);
+        batch->infer_batch_size = static_cast<uint32_t>(batch_size);
+        offset += n;
+    }
+    controller_.MaybeUpdate(now_us);
+    if (TraceRecorder::Enabled()) {
+        // 攒批等待计入各帧的 wait.infer, 推理区间从本次下发开始
+        for (TrackBatch* batch : *pending) {
+            TraceStage(kStageInfer, batch, begin);
+        }
+    }
+
+    counters.busy_ns.fetch_add(ElapsedNs(begin), std::memory_order_relaxed);
+    for (TrackBatch* batch : *pending) {
+        PushOutput(kStageInfer, batch);
+        counters.processed.fetch_add(1, std::memory_order_relaxed);
+    }
+    pending->clear();
+}
+
+void TrackPipeline::RunPublish() {
+    PinStage(kStagePublish);
+    StageCounters& counters = counters_[kStagePublish];
+    TrackBatch* batch;
+    bool upstream_done = false;
+    bool idle = true;
+    while (true) {
+        if (!TryPopInput(kStagePublish, &batch, &upstream_done)) {
+            if (upstream_done) {
+                break;
+            }
+            // 每段空闲只通知一次
+            if (!idle && publish_idle_) {
+                publish_idle_();
+                RecycleSent(0);
+            }
+            idle = true;
+            counters.starved.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::yield();
+            continue;
+        }
+        idle = false;
+        auto begin = PipelineClock::now();
+        const size_t total = batch->track_keys.size();
+        batch->labels.assign(total, -1);
+        size_t labeled = 0;
+        if (batch->ok && batch->logits.size() >= total) {
+            if (total > 0) {
+                // argmax 与 softmax 后的结果一致, 无需求指数
+                const size_t num_classes = batch->logits.size() / total;
+                for (size_t i = 0; i < total; ++i) {
+                    const float* row = batch->logits.data() + i * num_classes;
+                    batch->labels[i] = static_cast<int>(
+                        std::max_element(row, row + num_classes) - row);
+                }
+            }
+            inferred_windows_ += total;
+            labeled = total + (config_.associate_tracks ? FanOutLabels(batch) : 0);
+        } else {
+            // 推理失败: 标签全为 -1, 帧原样转发
+            batch->fanout_labels.assign(batch->fanout_keys.size(), -1);
+            failed_batches_++;
+        }
+        // 关联器已在窗口化阶段删除这些航迹, 推理成败都要清除其标签, 批号复用后不沿用旧目标的结果
+        for (TrackKey key : batch->removed_keys) {
+            rep_labels_.erase(key);
+        }
+        // 没有就绪窗口或推理失败的帧也照常发布, 保证下游帧序完整
+        size_t unsent = 0;
+        if (publish_) {
+            unsent = publish_(*batch);
+        }
+        if (labeled > 0) {
+            double latency_ms = ElapsedNs(batch->arrival) / 1e6;
+            latencies_ms_.insert(latencies_ms_.end(), labeled, latency_ms);
+            published_tracks_ += labeled;
+        }
+        if (batch->arena_slot >= 0) {
+            config_.arena->Release(static_cast<uint32_t>(batch->arena_slot));
+            batch->arena_slot = -1;
+        }
+        if (TraceRecorder::Enabled()) {
+            TraceStage(kStagePublish, batch, begin);
+            TraceTrackJourneys(*batch);
+            // 批号复用后重新命名, 行名在追踪器中按行覆盖
+            for (TrackKey key : batch->removed_keys) {
+                traced_tracks_.erase(key);
+            }
+        }
+        counters.busy_ns.fetch_add(ElapsedNs(begin), std::memory_order_relaxed);
+        counters.processed.fetch_add(1, std::memory_order_relaxed);
+        unsent_.push_back(batch);
+        RecycleSent(unsent);
+    }
+    if (publish_idle_) {
+        publish_idle_();
+    }
+    RecycleSent(0);
+    end_time_ = PipelineClock::now();
+    finished_[kStagePublish].store(true, std::memory_order_release);
+}
+
+void TrackPipeline::RecycleSent(size_t unsent) {
+    // 发布函数按顺序发送, 排队的总是最近的帧; recycle_ 容量等于句柄总数, 不会满
+    while (unsent_.size() > unsent) {
+        recycle_.TryPush(unsent_.front());
+        unsent_.pop_front();
+    }
+}
+
+size_t TrackPipeline::FanOutLabels(TrackBatch* batch) {
+    for (size_t i = 0; i < batch->track_keys.size(); ++i) {
+        rep_labels_[batch->track_keys[i]] = batch->labels[i];
+    }
+    // 代表与被抑制航迹来自不同雷达, 不在同一帧; 帧按序发布, 代表的标签来自更早的帧
+    size_t labeled = 0;
+    batch->fanout_labels.assign(batch->fanout_keys.size(), -1);
+    for (size_t i = 0; i < batch->fanout_keys.size(); ++i) {
+        auto it = rep_labels_.find(batch->fanout_reps[i]);
+        if (it != rep_labels_.end()) {
+            batch->fanout_labels[i] = it->second;
+            labeled++;
+        }
+    }
+    suppressed_windows_ += batch->fanout_keys.size();
+    fanout_unlabeled_ += batch->fanout_keys.size() - labeled;
+    return labeled;
+}
+
+PipelineReport TrackPipeline::Report() const {
+    PipelineReport report;
+    report.frames = counters_[kStagePublish].processed.load();
+    report.tracks = published_tracks_;
+    report.failed_batches = failed_batches_;
+    report.elapsed_sec = std::chrono::duration<double>(end_time_ - start_time_).count();
+    if (report.elapsed_sec > 0.0) {
+        report.tracks_per_sec = report.tracks / report.elapsed_sec;
+    }
+    report.latency_p50_ms = Percentile(latencies_ms_, 0.50);
+    report.latency_p99_ms = Percentile(latencies_ms_, 0.99);
+    report.latency_max_ms = latencies_ms_.empty() ? 0.0 :
+        *std::max_element(latencies_ms_.begin(), latencies_ms_.end());
+    report.inferred_windows = inferred_windows_;
+    report.suppressed_windows = suppressed_windows_;
+    report.fanout_unlabeled = fanout_unlabeled_;
+    return report;
+}
+
+void TrackPipeline::PrintReport(std::ostream& os) const {
+    PipelineReport report = Report();
+    os << "\n📊 流水线统计:" << std::endl;
+    os << "帧数: " << report.frames << ", 分类结果: " << report.tracks
+       << ", 失败批次: " << report.failed_batches << std::endl;
+    os << "耗时: " << std::fixed << std::setprecision(3) << report.elapsed_sec << " 秒, 吞吐: "
+       << std::setprecision(1) << report.tracks_per_sec << " 航迹/秒" << std::endl;
+    os << "端到端延迟(毫秒): p50=" << std::setprecision(4) << report.latency_p50_ms
+       << " p99=" << report.latency_p99_ms << " max=" << report.latency_max_ms << std::endl;
+
+    os << std::left << std::setw(10) << "阶段" << std::right
+       << std::setw(12) << "批次" << std::setw(12) << "平均占用" << std::setw(10) << "峰值"
+       << std::setw(14) << "反压次数" << std::setw(14) << "空转次数"
+       << std::setw(14) << "平均耗时us" << std::endl;
+    for (int stage = 0; stage < kStageCount; ++stage) {
+        const StageCounters& c = counters_[stage];
+        uint64_t processed = c.processed.load();
+        double avg_occupancy = processed ? static_cast<double>(c.occupancy_sum.load()) / processed : 0.0;
+        double avg_busy_us = processed ? c.busy_ns.load() / 1e3 / processed : 0.0;
+        os << std::left << std::setw(10) << PipelineStageName(stage) << std::right
+           << std::setw(12) << processed
+           << std::setw(12) << std::setprecision(2) << avg_occupancy
+           << std::setw(10) << c.occupancy_max.load()
+           << std::setw(14) << c.backpressure.load()
+           << std::setw(14) << c.starved.load()
+           << std::setw(14) << std::setprecision(2) << avg_busy_us << std::endl;
+    }
+
+    if (config_.adaptive_batching) {
+        BatchControllerMetrics metrics = controller_.Metrics();
+        os << "自适应批处理: 批大小=" << metrics.batch_size << " 等待=" << metrics.delay_us
+           << "us 最近p99=" << std::setprecision(3) << metrics.observed_p99_ms
+           << "ms 增大/减小/缩短等待=" << metrics.increases << "/" << metrics.decreases
+           << "/" << metrics.delay_cuts << std::endl;
+    }
+
+    if (config_.associate_tracks) {
+        const uint64_t windows = report.inferred_windows + report.suppressed_windows;
+        const TrackAssociationStats stats = associator_.Stats();
+        os << "重复航迹抑制: 推理窗口=" << report.inferred_windows << "/" << windows
+           << " (推理负载 " << std::setprecision(1)
+           << (windows ? 100.0 * report.inferred_windows / windows : 0.0) << "%) 抑制="
+           << report.suppressed_windows << " 代表尚无结果=" << report.fanout_unlabeled << std::endl;
+        os << "关联器: 航迹=" << stats.tracks << " 当前被抑制=" << stats.suppressed
+           << " 归组/脱离=" << stats.joins << "/" << stats.splits
+           << " 门限比较=" << stats.gate_checks << " (每次更新 " << std::setprecision(2)
+           << (stats.updates ? static_cast<double>(stats.gate_checks) / stats.updates : 0.0)
+           << ")" << std::endl;
+    }
+}
+
+bool ReplayFileSource::Load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "❌ 无法打开回放文件: " << path << std::endl;
+        return false;
+    }
+    data_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    offsets_.clear();
+
+    size_t pos = 0;
+    while (pos + sizeof(uint32_t) <= data_.size()) {
+        uint32_t length;
+        memcpy(&length, data_.data() + pos, sizeof(length));
+        pos += sizeof(length);
+        if (pos + length > data_.size()) {
+            std::cerr << "⚠️  回放文件末尾记录不完整, 已忽略" << std::endl;
+            break;
+        }
+        offsets_.emplace_back(pos, length);
+        pos += length;
+    }
+    return !offsets_.empty();
+}
+
+FrameSource ReplayFileSource::MakeSource(int loops) const {
+    auto index = std::make_shared<size_t>(0);
+    const size_t total = offsets_.size() * static_cast<size_t>(std::max(loops, 1));
+    return [this, index, total](std::vector<char>* frame) {
+        if (*index >= total) {
+            return false;
+        }
+        const auto& record = offsets_[(*index)++ % offsets_.size()];
+        frame->assign(data_.begin() + record.first,
+                      data_.begin() + record.first + record.second);
+        return true;
+    };
+}
@@ -0,0 +1,228 @@
+#pragma once
+
+// 航迹分类流水线: 接收 -> 解码 -> 窗口化 -> 推理 -> 发布
+// 每个阶段独占一个(可绑核)线程, 阶段之间通过 SPSC 环形队列传递批次句柄
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "batch_controller.h"
+#include "shm_tensor_arena.h"
+#include "spsc_queue.h"
+#include "track_association.h"
+#include "track_kinematics.h"
+#include "track_message.h"
+#include "track_window.h"
+
+using PipelineClock = std::chrono::steady_clock;
+
+enum PipelineStage {
+    kStageIngest = 0,
+    kStageDecode,
+    kStageWindow,
+    kStageInfer,
+    kStagePublish,
+    kStageCount
+};
+
+const char* PipelineStageName(int stage);
+
+// 批次句柄: 一帧报文从接收到发布的全部中间数据, 预分配后循环复用
+struct TrackBatch {
+    uint64_t sequence = 0;
+    PipelineClock::time_point arrival;  // 帧到达时间
+    std::vector<char> frame;            // 原始报文
+    OcdHead_t header;
+    std::vector<NetTrackItem_t> items;  // 解码后的航迹, 只有 TrackFeatureSchema 中的字段有效
+    std::vector<TrackKey> track_keys;   // 本帧产生就绪窗口的航迹
+    std::vector<int> track_items;       // [N] 对应航迹在本帧的序号, 不在本帧时为 -1
+    std::vector<float> windows;         // [N, 20, 14], 窗口未放入共享内存时使用
+    float* window_data = nullptr;       // 指向 windows 或共享内存槽位的输入区
+    int arena_slot = -1;                // 占用的共享内存槽位, 发布后归还
+    std::vector<float> extra_features;  // [N, kRollingFeatureDim], 开启滚动统计时与 track_keys 对应
+    std::vector<float> logits;          // [N, 类别数]
+    std::vector<int> labels;            // [N], 推理失败时全为 -1
+    // 开启重复航迹抑制时, 本帧窗口就绪但归入其他雷达代表航迹、不送推理的航迹及其代表;
+    // 发布阶段填入代表最近一次的标签, 代表尚无结果时为 -1
+    std::vector<TrackKey> fanout_keys;
+    std::vector<int> fanout_items;
+    std::vector<TrackKey> fanout_reps;
+    std::vector<int> fanout_labels;
+    std::vector<TrackKey> removed_keys; // 开启重复航迹抑制或请求追踪时本帧删除(状态 0)的航迹, 发布阶段据此清除其标签和追踪记录
+    bool ok = true;
+    // 开启请求追踪时记录的各阶段起止时间和推理批次号, 供发布阶段还原单条航迹的经过
+    PipelineClock::time_point stage_begin[kStageCount];
+    PipelineClock::time_point stage_end[kStageCount];
+    uint64_t infer_batch = 0;           // 首个窗口所在推理请求的批次号
+    uint32_t infer_window = 0;          // 首个窗口在该请求中的位置
+    uint32_t infer_batch_size = 0;      // 请求批大小, 后续窗口依次落在之后的请求中
+};
+
+// 推理函数: input 为 [batch_size, 20, 14], output 写入 [batch_size, 类别数]
+using InferFn = std::function<bool(const float* input, size_t batch_size,
+                                   std::vector<float>* output)>;
+// 发布函数: 在发布线程中调用, 可原地修改 batch->frame, 也可只引用其内存排队稍后发送;
+// 返回仍在排队的帧数(含本帧), 发布阶段按到达顺序保留这些帧的句柄, 发出后才归还
+using PublishFn = std::function<size_t(TrackBatch& batch)>;
+// 发布空闲函数: 发布线程输入为空时和退出前调用, 须发出全部排队的报文, 之后保留的句柄全部归还
+using PublishIdleFn = std::function<void()>;
+// 帧来源: 写入下一帧, 没有更多数据时返回 false
+using FrameSource = std::function<bool(std::vector<char>* frame)>;
+
+struct PipelineConfig {
+    size_t queue_capacity = 64;         // 阶段间队列容量
+    size_t batch_pool_size = 128;       // 预分配的批次句柄数, 决定在途帧上限
+    size_t max_infer_batch = 32;        // 单次推理最大批大小, 与 config.pbtxt 的 max_batch_size 一致
+    std::vector<int> stage_cpus;        // 各阶段绑定的CPU编号, 缺省或 <0 表示不绑定
+    TrackWindowConfig window;
+    // 开启后推理阶段跨帧攒批, 批大小和等待时间由 BatchController 按 p99 目标调整
+    bool adaptive_batching = false;
+    BatchControllerConfig batching;
+    // 非空时窗口化阶段把窗口直接写入共享内存槽位, 推理请求只携带偏移;
+    // 槽位不足或窗口数超过槽位容量时回退到 TrackBatch::windows
+    SharedTensorArena* arena = nullptr;
+    // 开启后窗口化阶段同时维护每条航迹的滚动运动学统计, 输出到 TrackBatch::extra_features
+    bool rolling_features = false;
+    RollingFeatureConfig rolling;
+    // 开启后窗口化阶段按地心坐标和速度关联不同雷达上报的同一目标, 每组只推理代表航迹,
+    // 其余航迹在发布阶段沿用代表的标签(TrackBatch::fanout_*)
+    bool associate_tracks = false;
+    TrackAssociationConfig association;
+};
+
+// 单个阶段的运行计数, 由阶段线程写入, 任意线程可读
+struct StageCounters {
+    std::atomic<uint64_t> processed{0};        // 处理的批次数
+    std::atomic<uint64_t> backpressure{0};     // 下游队列满导致的等待次数
+    std::atomic<uint64_t> starved{0};          // 上游队列空导致的等待次数
+    std::atomic<uint64_t> occupancy_sum{0};    // 每次取出时输入队列占用量之和
+    std::atomic<uint64_t> occupancy_max{0};    // 输入队列占用量峰值
+    std::atomic<uint64_t> busy_ns{0};          // 处理耗时
+};
+
+struct PipelineReport {
+    uint64_t frames = 0;
+    uint64_t tracks = 0;            // 发布的分类结果数, 含沿用代表标签的重复航迹
+    uint64_t failed_batches = 0;
+    double elapsed_sec = 0.0;
+    double tracks_per_sec = 0.0;
+    double latency_p50_ms = 0.0;    // 帧到达 -> 标签发布
+    double latency_p99_ms = 0.0;
+    double latency_max_ms = 0.0;
+    uint64_t inferred_windows = 0;  // 送推理的窗口数
+    uint64_t suppressed_windows = 0;    // 重复航迹抑制后未送推理的窗口数
+    uint64_t fanout_unlabeled = 0;  // 被抑制时代表尚无分类结果、未发布标签的窗口数
+};
+
+class TrackPipeline {
+public:
+    TrackPipeline(const PipelineConfig& config, InferFn infer, PublishFn publish = nullptr,
+                  PublishIdleFn publish_idle = nullptr);
+    ~TrackPipeline();
+
+    TrackPipeline(const TrackPipeline&) = delete;
+    TrackPipeline& operator=(const TrackPipeline&) = delete;
+
+    // 启动全部阶段线程, source 在接收线程中被调用
+    void Start(FrameSource source);
+    // 等待数据源耗尽且所有在途批次发布完毕
+    void Wait();
+
+    const StageCounters& Counters(int stage) const { return counters_[stage]; }
+    PipelineReport Report() const;
+    void PrintReport(std::ostream& os) const;
+    // 自适应批处理控制器, 仅在 Wait() 返回后读取
+    const BatchController& Controller() const { return controller_; }
+    // 重复航迹关联器, 仅在 Wait() 返回后读取
+    const TrackAssociator& Associator() const { return associator_; }
+
+private:
+    using BatchQueue = SpscQueue<TrackBatch*>;
+
+    void RunIngest(FrameSource source);
+    void RunDecode();
+    void RunWindow();
+    void RunInfer();
+    void RunAdaptiveInfer();
+    void RunPublish();
+
+    // 合并 pending 中各帧的窗口, 按控制器当前批大小推理后把结果拆回各帧并下发
+    void DispatchPending(std::deque<TrackBatch*>* pending);
+    // 归还已发出的句柄, 只保留最近 unsent 个
+    void RecycleSent(size_t unsent);
+    // 记录本帧代表航迹的标签, 并为被抑制的重复航迹填入其代表最近一次的标签, 返回填入的个数
+    size_t FanOutLabels(TrackBatch* batch);
+
+    // 从 stage 的输入队列取批次, 上游结束且队列为空时返回 false
+    bool PopInput(int stage, TrackBatch** batch);
+    // 非阻塞取批次, upstream_done 返回上游是否已结束
+    bool TryPopInput(int stage, TrackBatch** batch, bool* upstream_done);
+    // 推送到下游队列, 队列满时自旋等待(显式反压)
+    void PushOutput(int stage, TrackBatch* batch);
+    void PinStage(int stage) const;
+    // 调用推理函数; 开启追踪时标记当前批次号并记录请求区间
+    bool CallInfer(uint64_t batch_id, const float* input, size_t count, std::vector<float>* output);
+    // 追踪: 记录本帧在 stage 的起止时间和线程时间线上的区间
+    void TraceStage(int stage, TrackBatch* batch, PipelineClock::time_point begin);
+    // 追踪: 在发布阶段为抽中的航迹输出从接收到发布的各段区间
+    void TraceTrackJourneys(const TrackBatch& batch);
+
+    PipelineConfig config_;
+    InferFn infer_;
+    PublishFn publish_;
+    PublishIdleFn publish_idle_;
+
+    std::vector<std::unique_ptr<TrackBatch>> pool_;
+    // queues_[i] 为阶段 i -> i+1 的队列, recycle_ 由发布阶段归还句柄给接收阶段
+    std::vector<std::unique_ptr<BatchQueue>> queues_;
+    BatchQueue recycle_;
+    std::deque<TrackBatch*> unsent_;    // 已交给发布函数、报文尚未发出的句柄, 仅发布线程访问
+
+    StageCounters counters_[kStageCount];
+    std::atomic<bool> finished_[kStageCount];
+    std::vector<std::thread> threads_;
+
+    TrackWindowStore window_store_;     // 仅窗口化线程访问
+    RollingFeatureEngine rolling_;      // 仅窗口化线程访问
+    TrackAssociator associator_;        // 仅窗口化线程访问
+    std::unordered_map<TrackKey, int> frame_index_;     // 本帧航迹键 -> 帧内序号, 仅窗口化线程访问
+    BatchController controller_;        // 仅推理线程访问
+    std::vector<float> staging_;        // 跨帧攒批时的连续输入缓冲
+    int staging_slot_ = -1;             // 攒批缓冲使用的共享内存槽位
+    std::vector<float> staged_logits_;
+    uint64_t next_infer_batch_ = 1;     // 推理请求批次号, 仅推理线程访问
+    std::unordered_set<TrackKey> traced_tracks_;    // 已命名时间线的航迹, 航迹删除时清除, 仅发布线程访问
+    std::vector<double> latencies_ms_;  // 仅发布线程写入
+    uint64_t published_tracks_ = 0;
+    std::unordered_map<TrackKey, int> rep_labels_;  // 代表航迹最近一次的标签, 航迹删除时清除, 仅发布线程访问
+    uint64_t inferred_windows_ = 0;
+    uint64_t suppressed_windows_ = 0;
+    uint64_t fanout_unlabeled_ = 0;
+    uint64_t failed_batches_ = 0;
+    PipelineClock::time_point start_time_;
+    PipelineClock::time_point end_time_;
+};
+
+// 回放文件: 连续记录, 每条为 uint32 帧长(主机字节序) + 帧内容
+// 文件一次性读入内存, 避免磁盘IO影响测量
+class ReplayFileSource {
+public:
+    bool Load(const std::string& path);
+    size_t FrameCount() const { return offsets_.size(); }
+    // 生成按顺序回放 loops 遍的帧来源
+    FrameSource MakeSource(int loops = 1) const;
+
+private:
+    std::vector<char> data_;
+    std::vector<std::pair<size_t, uint32_t>> offsets_;
+};
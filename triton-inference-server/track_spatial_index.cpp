@@ -0,0 +1,410 @@
+#include "track_spatial_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// 单次查询最多扫描的网格数, 超过后退回线性扫描(查询半径远大于网格时更快)
+constexpr size_t kMaxScanCells = 4096;
+// k 近邻第二步的立方体每个方向最多跨越的网格数(差值), 即最多 4x4x4 个网格
+constexpr int32_t kMaxNearestSpan = 3;
+
+double Square(double v) {
+    return v * v;
+}
+
+// 向下取整; 未开启 SSE4.1 时 std::floor 是函数调用, 查询中每条候选都要算网格号
+int32_t FloorIndex(double v) {
+    const int32_t i = static_cast<int32_t>(v);
+    return i - (v < i);
+}
+
+// 坐标 v 到第 index 个网格(边长 s)区间的距离平方, v 在区间内时为 0
+double AxisGap2(double v, int32_t index, double s) {
+    const double lo = index * s;
+    if (v < lo) {
+        return Square(lo - v);
+    }
+    const double hi = lo + s;
+    return v > hi ? Square(v - hi) : 0.0;
+}
+
+}  // namespace
+
+TrackSpatialIndex::TrackSpatialIndex(const TrackSpatialIndexConfig& config)
+    : config_(config) {
+    config_.cell_size = std::max(config_.cell_size, 1.0);
+    config_.levels = std::max(config_.levels, 1);
+    config_.level_ratio = std::max(config_.level_ratio, 2.0);
+    size_t buckets = 1;
+    while (buckets < config_.bucket_count) {
+        buckets <<= 1;
+    }
+    config_.bucket_count = buckets;
+    bucket_mask_ = buckets - 1;
+
+    levels_.resize(config_.levels);
+    double cell_size = config_.cell_size;
+    for (Level& level : levels_) {
+        level.cell_size = cell_size;
+        level.inv_cell = 1.0 / cell_size;
+        level.buckets.resize(buckets);
+        cell_size *= config_.level_ratio;
+    }
+}
+
+TrackSpatialIndex::Cell TrackSpatialIndex::Level::CellOf(double x, double y, double z) const {
+    Cell cell;
+    cell.ix = FloorIndex(x * inv_cell);
+    cell.iy = FloorIndex(y * inv_cell);
+    cell.iz = FloorIndex(z * inv_cell);
+    return cell;
+}
+
+size_t TrackSpatialIndex::BucketOf(const Cell& cell) const {
+    uint32_t h = static_cast<uint32_t>(cell.ix) * 73856093u ^
+                 static_cast<uint32_t>(cell.iy) * 19349663u ^
+                 static_cast<uint32_t>(cell.iz) * 83492791u;
+    return h & bucket_mask_;
+}
+
+void TrackSpatialIndex::Link(Level* level, uint32_t slot, double x, double y, double z) {
+    const size_t b = BucketOf(level->cells[slot]);
+    std::vector<Entry>& bucket = level->buckets[b];
+    level->bucket_of[slot] = static_cast<uint32_t>(b);
+    level->bucket_pos[slot] = static_cast<uint32_t>(bucket.size());
+    bucket.push_back({x, y, z, level->cells[slot], slot});
+}
+
+void TrackSpatialIndex::Unlink(Level* level, uint32_t slot) {
+    std::vector<Entry>& bucket = level->buckets[level->bucket_of[slot]];
+    uint32_t pos = level->bucket_pos[slot];
+    bucket[pos] = bucket.back();
+    level->bucket_pos[bucket[pos].slot] = pos;
+    bucket.pop_back();
+}
+
+void TrackSpatialIndex::Update(TrackKey track_key, double x, double y, double z) {
+    auto it = slot_of_.find(track_key);
+    if (it != slot_of_.end()) {
+        uint32_t slot = it->second;
+        // 航迹每帧移动距离远小于网格边长, 多数情况下各级网格都不变, 只改写条目坐标
+        for (Level& level : levels_) {
+            Cell cell = level.CellOf(x, y, z);
+            if (level.cells[slot] == cell) {
+                Entry& entry = level.buckets[level.bucket_of[slot]][level.bucket_pos[slot]];
+                entry.x = x;
+                entry.y = y;
+                entry.z = z;
+            } else {
+                Unlink(&level, slot);
+                level.cells[slot] = cell;
+                Link(&level, slot, x, y, z);
+            }
+        }
+        return;
+    }
+
+    uint32_t slot;
+    if (!free_slots_.empty()) {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(keys_.size());
+        keys_.push_back(0);
+        for (Level& level : levels_) {
+            level.cells.emplace_back();
+            level.bucket_of.push_back(0);
+            level.bucket_pos.push_back(0);
+        }
+    }
+    keys_[slot] = track_key;
+    for (Level& level : levels_) {
+        level.cells[slot] = level.CellOf(x, y, z);
+        Link(&level, slot, x, y, z);
+    }
+    slot_of_.emplace(track_key, slot);
+}
+
+void TrackSpatialIndex::Remove(TrackKey track_key) {
+    auto it = slot_of_.find(track_key);
+    if (it == slot_of_.end()) {
+        return;
+    }
+    for (Level& level : levels_) {
+        Unlink(&level, it->second);
+    }
+    free_slots_.push_back(it->second);
+    slot_of_.erase(it);
+}
+
+void TrackSpatialIndex::Clear() {
+    slot_of_.clear();
+    free_slots_.clear();
+    keys_.clear();
+    for (Level& level : levels_) {
+        level.cells.clear();
+        level.bucket_of.clear();
+        level.bucket_pos.clear();
+        for (std::vector<Entry>& bucket : level.buckets) {
+            bucket.clear();
+        }
+    }
+}
+
+void TrackSpatialIndex::UpdateTrackItem(const OcdHead_t& header, const NetTrackItem_t& item) {
+    TrackKey key = MakeTrackKey(header, item);
+    if (item.status == 0) {
+        // 目标丢失
+        Remove(key);
+        return;
+    }
+    // 地心坐标量化单位 0.01 米
+    Update(key, item.tgtX * 0.01, item.tgtY * 0.01, item.tgtZ * 0.01);
+}
+
+bool TrackSpatialIndex::Position(TrackKey track_key, double* x, double* y, double* z) const {
+    auto it = slot_of_.find(track_key);
+    if (it == slot_of_.end()) {
+        return false;
+    }
+    const Level& level = levels_[0];
+    const Entry& entry = level.buckets[level.bucket_of[it->second]][level.bucket_pos[it->second]];
+    *x = entry.x;
+    *y = entry.y;
+    *z = entry.z;
+    return true;
+}
+
+template <typename Visit>
+void TrackSpatialIndex::ScanCell(const Level& level, const Cell& cell, double x, double y,
+                                 double z, const double& max_dist2, Visit&& visit) const {
+    for (const Entry& entry : level.buckets[BucketOf(cell)]) {
+        if (!(entry.cell == cell)) {
+            continue;
+        }
+        double dx = entry.x - x;
+        double dy = entry.y - y;
+        double dz = entry.z - z;
+        double d2 = dx * dx + dy * dy + dz * dz;
+        if (d2 <= max_dist2) {
+            visit(entry, d2);
+        }
+    }
+}
+
+template <typename Visit>
+void TrackSpatialIndex::ScanAll(double x, double y, double z, const double& max_dist2,
+                                Visit&& visit) const {
+    // 最细一级的桶合起来恰好含每条航迹一次
+    for (const std::vector<Entry>& bucket : levels_[0].buckets) {
+        for (const Entry& entry : bucket) {
+            double dx = entry.x - x;
+            double dy = entry.y - y;
+            double dz = entry.z - z;
+            double d2 = dx * dx + dy * dy + dz * dz;
+            if (d2 <= max_dist2) {
+                visit(entry, d2);
+            }
+        }
+    }
+}
+
+size_t TrackSpatialIndex::QueryRadius(double x, double y, double z, double radius,
+                                      std::vector<TrackNeighbor>* out) const {
+    const size_t before = out->size();
+    const double r2 = radius * radius;
+    auto visit = [&](const Entry& entry, double d2) { out->push_back({keys_[entry.slot], d2}); };
+
+    // 网格边长不小于半径的最细一级, 查询立方体每个方向最多跨 3 个网格
+    size_t l = 0;
+    while (l + 1 < levels_.size() && levels_[l].cell_size < radius) {
+        ++l;
+    }
+    const Level& level = levels_[l];
+    Cell lo = level.CellOf(x - radius, y - radius, z - radius);
+    Cell hi = level.CellOf(x + radius, y + radius, z + radius);
+    double cells = double(hi.ix - lo.ix + 1) * (hi.iy - lo.iy + 1) * (hi.iz - lo.iz + 1);
+    if (cells > kMaxScanCells || cells > slot_of_.size()) {
+        // 半径超出最粗一级或航迹很少, 直接逐条比较
+        ScanAll(x, y, z, r2, visit);
+        return out->size() - before;
+    }
+
+    Cell cell;
+    for (cell.ix = lo.ix; cell.ix <= hi.ix; ++cell.ix) {
+        for (cell.iy = lo.iy; cell.iy <= hi.iy; ++cell.iy) {
+            for (cell.iz = lo.iz; cell.iz <= hi.iz; ++cell.iz) {
+                ScanCell(level, cell, x, y, z, r2, visit);
+            }
+        }
+    }
+    return out->size() - before;
+}
+
+size_t TrackSpatialIndex::NearestStartLevel(double x, double y, double z, size_t k) const {
+    // 所在网格的桶里已有 k 条航迹的最细一级(桶可能混有其他网格的航迹, 只作密度估计),
+    // 更细的级别 3x3x3 邻域多半凑不够 k 个, 扫了也要到更粗一级重来
+    for (size_t l = 0; l + 1 < levels_.size(); ++l) {
+        const Level& level = levels_[l];
+        if (level.buckets[BucketOf(level.CellOf(x, y, z))].size() >= k) {
+            return l;
+        }
+    }
+    return levels_.size() - 1;
+}
+
+void TrackSpatialIndex::QueryNearest(double x, double y, double z, size_t k,
+                                     std::vector<TrackNeighbor>* out) const {
+    out->clear();
+    if (k == 0 || slot_of_.empty()) {
+        return;
+    }
+    k = std::min(k, slot_of_.size());
+
+    // 已扫描过的更细一级 3x3x3 范围, 其中的航迹已比较过, 换到更粗一级时跳过
+    const Level* done_level = nullptr;
+    Cell done_lo;
+    Cell done_hi;
+    // out 按距离升序保存至多 k 个候选, 跨级保留; limit 为当前第 k 近, 只会缩小,
+    // ScanCell 每比较一条都重新读取, 比堆少做大量无效插入; 常用的 k 很小, 有序插入即可
+    double limit = std::numeric_limits<double>::infinity();
+    auto visit = [&](const Entry& entry, double d2) {
+        if (done_level) {
+            const Cell cell = done_level->CellOf(entry.x, entry.y, entry.z);
+            if (cell.ix >= done_lo.ix && cell.ix <= done_hi.ix && cell.iy >= done_lo.iy &&
+                cell.iy <= done_hi.iy && cell.iz >= done_lo.iz && cell.iz <= done_hi.iz) {
+                return;
+            }
+        }
+        if (d2 >= limit) {
+            return;
+        }
+        size_t i = out->size();
+        if (i < k) {
+            out->emplace_back();
+        } else {
+            --i;
+        }
+        for (; i > 0 && (*out)[i - 1].dist2 > d2; --i) {
+            (*out)[i] = (*out)[i - 1];
+        }
+        (*out)[i] = {keys_[entry.slot], d2};
+        if (out->size() == k) {
+            limit = out->back().dist2;
+        }
+    };
+
+    // 第一步: 扫描查询点所在网格及其 26 邻格, 凑够 k 个候选得到第 k 近的上界, 凑不够时换更粗一级;
+    // 已扫描立方体外的点距离不小于查询点到立方体边界的距离, 第 k 近不超过该距离即可结束
+    for (size_t l = NearestStartLevel(x, y, z, k); l < levels_.size(); ++l) {
+        const Level& level = levels_[l];
+        const double s = level.cell_size;
+        const Cell c = level.CellOf(x, y, z);
+        const double gap2[3][3] = {
+            {AxisGap2(x, c.ix - 1, s), 0.0, AxisGap2(x, c.ix + 1, s)},
+            {AxisGap2(y, c.iy - 1, s), 0.0, AxisGap2(y, c.iy + 1, s)},
+            {AxisGap2(z, c.iz - 1, s), 0.0, AxisGap2(z, c.iz + 1, s)},
+        };
+        // 依次扫描所在网格、面邻格、棱邻格、角邻格, 由近及远尽早收紧第 k 近;
+        // 所在网格已凑够 k 个时不再扫邻格, 交给第二步在更合适的一级上补全;
+        // 已扫过更细一级时所在网格未必包含上一级的 3x3x3, 不能以它作为已扫描范围
+        ScanCell(level, c, x, y, z, limit, visit);
+        if (out->size() == k && !done_level) {
+            done_level = &level;
+            done_lo = c;
+            done_hi = c;
+            break;
+        }
+        for (int ring = 1; ring <= 3; ++ring) {
+            for (int32_t dx = -1; dx <= 1; ++dx) {
+                for (int32_t dy = -1; dy <= 1; ++dy) {
+                    for (int32_t dz = -1; dz <= 1; ++dz) {
+                        if ((dx != 0) + (dy != 0) + (dz != 0) != ring) {
+                            continue;
+                        }
+                        // 邻格内最近的点也比当前第 k 近远时跳过
+                        if (gap2[0][dx + 1] + gap2[1][dy + 1] + gap2[2][dz + 1] > limit) {
+                            continue;
+                        }
+                        ScanCell(level, {c.ix + dx, c.iy + dy, c.iz + dz}, x, y, z, limit, visit);
+                    }
+                }
+            }
+        }
+        double margin = std::min({x - (c.ix - 1) * s, (c.ix + 2) * s - x,
+                                  y - (c.iy - 1) * s, (c.iy + 2) * s - y,
+                                  z - (c.iz - 1) * s, (c.iz + 2) * s - z});
+        if (limit <= margin * margin) {
+            return;
+        }
+        // 更粗一级的 3x3x3 范围包含本级的, 只需记最近一次
+        done_level = &level;
+        done_lo = {c.ix - 1, c.iy - 1, c.iz - 1};
+        done_hi = {c.ix + 1, c.iy + 1, c.iz + 1};
+        if (out->size() == k) {
+            break;
+        }
+    }
+
+    if (out->size() == k) {
+        // 第二步: 第 k 近不超过 d, 只需检查以查询点为中心、半径 d 的球; 取立方体 [q-d, q+d]
+        // 每个方向不超过 kMaxNearestSpan 个网格的最细一级, 扫描与球相交、且不在第一步范围内的网格.
+        // 直接换到下一级的 3x3x3 时网格边长跳变 level_ratio 倍, 候选数往往多出数倍
+        const double d = std::sqrt(limit);
+        size_t l = 0;
+        Cell lo;
+        Cell hi;
+        for (;; ++l) {
+            lo = levels_[l].CellOf(x - d, y - d, z - d);
+            hi = levels_[l].CellOf(x + d, y + d, z + d);
+            if (l + 1 == levels_.size() ||
+                std::max({hi.ix - lo.ix, hi.iy - lo.iy, hi.iz - lo.iz}) < kMaxNearestSpan) {
+                break;
+            }
+        }
+        const Level& level = levels_[l];
+        double cells = double(hi.ix - lo.ix + 1) * (hi.iy - lo.iy + 1) * (hi.iz - lo.iz + 1);
+        if (cells <= kMaxScanCells) {
+            const double s = level.cell_size;
+            // 网格的最小、最大角都落在第一步范围内时整格跳过
+            auto done = [&](double cx, double cy, double cz) {
+                const Cell a = done_level->CellOf(cx, cy, cz);
+                return a.ix >= done_lo.ix && a.ix <= done_hi.ix && a.iy >= done_lo.iy &&
+                       a.iy <= done_hi.iy && a.iz >= done_lo.iz && a.iz <= done_hi.iz;
+            };
+            const double inner = s * (1.0 - 1e-9);
+            Cell cell;
+            for (cell.ix = lo.ix; cell.ix <= hi.ix; ++cell.ix) {
+                const double gx = AxisGap2(x, cell.ix, s);
+                for (cell.iy = lo.iy; cell.iy <= hi.iy; ++cell.iy) {
+                    const double gxy = gx + AxisGap2(y, cell.iy, s);
+                    if (gxy > limit) {
+                        continue;
+                    }
+                    for (cell.iz = lo.iz; cell.iz <= hi.iz; ++cell.iz) {
+                        if (gxy + AxisGap2(z, cell.iz, s) > limit) {
+                            continue;
+                        }
+                        const double cx = cell.ix * s;
+                        const double cy = cell.iy * s;
+                        const double cz = cell.iz * s;
+                        if (done(cx, cy, cz) && done(cx + inner, cy + inner, cz + inner)) {
+                            continue;
+                        }
+                        ScanCell(level, cell, x, y, z, limit, visit);
+                    }
+                }
+            }
+            return;
+        }
+    }
+
+    // 目标稀疏, 最粗一级的邻域内也凑不够 k 个
+    out->clear();
+    done_level = nullptr;
+    limit = std::numeric_limits<double>::infinity();
+    ScanAll(x, y, z, limit, visit);
+}
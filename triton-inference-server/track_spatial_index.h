@@ -0,0 +1,106 @@
+#pragma once
+
+// 航迹空间索引: 多级均匀网格 + 空间哈希, 随航迹更新/丢失增量维护,
+// 支持半径查询和 k 近邻查询, 用于威胁区、机场半径、鸟群聚类等"附近有哪些航迹"的判断,
+// 代替对全部航迹的线性扫描
+//
+// 每级网格边长是上一级的 level_ratio 倍, 每条航迹在各级中都有登记;
+// 查询时选网格边长不小于查询范围的一级, 最多扫描 3x3x3 个网格
+//
+// 坐标为任意米制笛卡尔坐标: 可用报文中的地心 tgtX/Y/Z, 也可用宿主程序中的 mapXYZPos;
+// 宿主程序在 TrackFile::SaveTrack / DelTrackByPH 处分别调用 Update / Remove 即可保持同步
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "track_message.h"
+
+struct TrackSpatialIndexConfig {
+    double cell_size = 500.0;       // 最细一级的网格边长(米), 取最小常用查询半径附近的值
+    int levels = 3;                 // 网格级数, 缺省为 500m / 2km / 8km
+    double level_ratio = 4.0;
+    size_t bucket_count = 4096;     // 每级哈希桶数, 取不小于航迹数 2 倍的 2 的幂
+};
+
+struct TrackNeighbor {
+    TrackKey key = 0;
+    double dist2 = 0.0;             // 距离平方(米^2)
+};
+
+class TrackSpatialIndex {
+public:
+    explicit TrackSpatialIndex(const TrackSpatialIndexConfig& config = TrackSpatialIndexConfig());
+
+    // 写入或移动一条航迹, 仍在同一网格内时只更新坐标
+    void Update(TrackKey track_key, double x, double y, double z);
+    void Remove(TrackKey track_key);
+    void Clear();
+
+    // 直接写入解码后的航迹报文条目: 状态 0 删除, 其余按地心坐标更新
+    void UpdateTrackItem(const OcdHead_t& header, const NetTrackItem_t& item);
+
+    // 距离不超过 radius 的航迹, 追加到 out, 不保证顺序; 返回找到的个数
+    size_t QueryRadius(double x, double y, double z, double radius,
+                       std::vector<TrackNeighbor>* out) const;
+    // 最近的 k 条航迹, 按距离升序写入 out(会先清空)
+    void QueryNearest(double x, double y, double z, size_t k,
+                      std::vector<TrackNeighbor>* out) const;
+
+    bool Position(TrackKey track_key, double* x, double* y, double* z) const;
+    size_t TrackCount() const { return slot_of_.size(); }
+    const TrackSpatialIndexConfig& config() const { return config_; }
+
+private:
+    struct Cell {
+        int32_t ix = 0;
+        int32_t iy = 0;
+        int32_t iz = 0;
+        bool operator==(const Cell& o) const { return ix == o.ix && iy == o.iy && iz == o.iz; }
+    };
+
+    // 桶内条目带坐标和网格, 扫描一个网格只顺序读一段连续内存
+    struct Entry {
+        double x;
+        double y;
+        double z;
+        Cell cell;
+        uint32_t slot;
+    };
+
+    struct Level {
+        double cell_size = 0.0;
+        double inv_cell = 0.0;
+        std::vector<Cell> cells;            // 按槽位下标
+        std::vector<uint32_t> bucket_of;    // 槽位所在的桶
+        std::vector<uint32_t> bucket_pos;   // 槽位在所属桶中的下标, 删除时 O(1) 交换移除
+        // 不同网格可能落入同一个桶, 扫描时按条目的网格过滤
+        std::vector<std::vector<Entry>> buckets;
+
+        Cell CellOf(double x, double y, double z) const;
+    };
+
+    size_t BucketOf(const Cell& cell) const;
+    void Link(Level* level, uint32_t slot, double x, double y, double z);
+    void Unlink(Level* level, uint32_t slot);
+    // 扫描一个网格, 把距离平方不超过 max_dist2 的条目交给 visit;
+    // max_dist2 按引用逐条读取, visit 可在扫描中收紧它
+    template <typename Visit>
+    void ScanCell(const Level& level, const Cell& cell, double x, double y, double z,
+                  const double& max_dist2, Visit&& visit) const;
+    // k 近邻查询的起始级别
+    size_t NearestStartLevel(double x, double y, double z, size_t k) const;
+    template <typename Visit>
+    void ScanAll(double x, double y, double z, const double& max_dist2, Visit&& visit) const;
+
+    TrackSpatialIndexConfig config_;
+    size_t bucket_mask_ = 0;
+    std::vector<Level> levels_;
+
+    std::unordered_map<TrackKey, uint32_t> slot_of_;
+    std::vector<uint32_t> free_slots_;
+
+    // 按槽位下标访问, 坐标只存在各级桶的条目中
+    std::vector<TrackKey> keys_;
+};
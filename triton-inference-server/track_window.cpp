@@ -0,0 +1,245 @@
+#include "track_window.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 一天的秒数, 用于处理航迹时间跨零点
+constexpr double kSecondsPerDay = 86400.0;
+
+// 周期性特征(角度), 存储时展开为连续值, 插值后再折回 [0, 360)
+constexpr int kCircularFeatures[] = {kFeatAzimuth, kFeatCourse};
+
+float UnwrapDegrees(float value, float previous) {
+    float delta = value - previous;
+    delta -= 360.0f * std::round(delta / 360.0f);
+    return previous + delta;
+}
+
+}  // namespace
+
+void ExtractTrackFeatures(const NetTrackItem_t& item, float* features) {
+    features[kFeatRange] = item.tgt_rng * 0.1f;
+    features[kFeatAzimuth] = item.tgt_azi * 0.00001f;
+    features[kFeatElevation] = item.tgt_ele * 0.00001f;
+    features[kFeatRadialVel] = item.radial_vel * 0.01f;
+    features[kFeatAziVel] = item.azi_vel * 0.001f;
+    features[kFeatEleVel] = item.ele_vel * 0.001f;
+    features[kFeatSpeed] = item.speed * 0.1f;
+    features[kFeatAcc] = item.acc * 0.01f;
+    features[kFeatCourse] = item.course * 0.1f;
+    features[kFeatAmp] = item.amp * 0.1f;
+    features[kFeatSnr] = item.snr * 0.01f;
+    features[kFeatRcs] = item.rcs * 0.01f;
+    features[kFeatAzErrStd] = item.az_err_std * 0.001f;
+    features[kFeatEleErrStd] = item.ele_err_std * 0.001f;
+}
+
+TrackWindowStore::TrackWindowStore(const TrackWindowConfig& config)
+    : config_(config) {
+    // 至少要能容纳一个完整窗口
+    config_.history_capacity = std::max<size_t>(config_.history_capacity, kWindowSteps);
+    config_.emit_stride = std::max(config_.emit_stride, 1);
+}
+
+size_t TrackWindowStore::AcquireSlot(TrackKey track_key) {
+    auto it = slot_of_.find(track_key);
+    if (it != slot_of_.end()) {
+        return it->second;
+    }
+
+    size_t slot;
+    if (!free_slots_.empty()) {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+        slots_[slot] = TrackSlot();
+    } else {
+        slot = slots_.size();
+        slots_.emplace_back();
+        times_.resize(times_.size() + config_.history_capacity);
+        samples_.resize(samples_.size() + config_.history_capacity * kFeatureDim);
+    }
+    slots_[slot].key = track_key;
+    slot_of_.emplace(track_key, slot);
+    return slot;
+}
+
+double TrackWindowStore::SlotStep(const TrackSlot& slot) const {
+    if (config_.step_sec > 0.0) {
+        return config_.step_sec;
+    }
+    return slot.step > 0.0 ? slot.step : config_.default_step_sec;
+}
+
+size_t TrackWindowStore::SampleIndex(size_t slot, size_t i) const {
+    const size_t cap = config_.history_capacity;
+    const TrackSlot& s = slots_[slot];
+    size_t oldest = (s.head + cap - s.count) % cap;
+    return slot * cap + (oldest + i) % cap;
+}
+
+void TrackWindowStore::AddSample(TrackKey track_key, double timestamp,
+                                 const float* features, double step_hint) {
+    const size_t cap = config_.history_capacity;
+    size_t slot = AcquireSlot(track_key);
+    TrackSlot& s = slots_[slot];
+
+    // 北京时跨零点后时间回绕, 累加一天保证单调
+    if (s.last_raw_time >= 0.0 && timestamp < s.last_raw_time - kSecondsPerDay / 2) {
+        s.day_offset += kSecondsPerDay;
+    }
+    s.last_raw_time = timestamp;
+    double t = timestamp + s.day_offset;
+
+    const float* previous = nullptr;
+    if (s.count > 0) {
+        size_t last = SampleIndex(slot, s.count - 1);
+        double dt = t - times_[last];
+        if (dt <= 0.0) {
+            // 重复或乱序的点直接丢弃
+            return;
+        }
+        if (dt > config_.max_gap_sec) {
+            // 断批后旧历史不可用于插值
+            s.count = 0;
+            s.head = 0;
+            s.fresh = 0;
+        } else {
+            previous = &samples_[last * kFeatureDim];
+        }
+    }
+
+    size_t index = slot * cap + s.head;
+    times_[index] = t;
+    float* dst = &samples_[index * kFeatureDim];
+    std::copy(features, features + kFeatureDim, dst);
+    if (previous) {
+        for (int f : kCircularFeatures) {
+            dst[f] = UnwrapDegrees(dst[f], previous[f]);
+        }
+    }
+
+    s.head = (s.head + 1) % cap;
+    s.count = std::min(s.count + 1, cap);
+    s.fresh++;
+    if (step_hint > 0.0) {
+        s.step = step_hint;
+    }
+}
+
+void TrackWindowStore::AddTrackItem(const OcdHead_t& header, const NetTrackItem_t& item) {
+    TrackKey key = MakeTrackKey(header, item);
+    if (item.status == 0) {
+        // 目标丢失
+        RemoveTrack(key);
+        return;
+    }
+
+    float features[kFeatureDim];
+    ExtractTrackFeatures(item, features);
+    AddSample(key, TrackTimeOfDay(header, item), features, item.tas_prd * 0.001);
+}
+
+void TrackWindowStore::RemoveTrack(TrackKey track_key) {
+    auto it = slot_of_.find(track_key);
+    if (it == slot_of_.end()) {
+        return;
+    }
+    slots_[it->second] = TrackSlot();
+    free_slots_.push_back(it->second);
+    slot_of_.erase(it);
+}
+
+void TrackWindowStore::Clear() {
+    slot_of_.clear();
+    slots_.clear();
+    free_slots_.clear();
+    times_.clear();
+    samples_.clear();
+}
+
+size_t TrackWindowStore::BuildReadyWindows(std::vector<TrackKey>* track_keys,
+                                           std::vector<float>* windows) {
+    const size_t num_windows = PlanReadyWindows(track_keys);
+    windows->resize(num_windows * kWindowSteps * kFeatureDim);
+    ResampleReadyWindows(windows->data());
+    return num_windows;
+}
+
+size_t TrackWindowStore::PlanReadyWindows(std::vector<TrackKey>* track_keys,
+                                          const std::function<bool(TrackKey)>& skip,
+                                          std::vector<TrackKey>* skipped) {
+    track_keys->clear();
+    lo_index_.clear();
+    hi_index_.clear();
+    weight_.clear();
+
+    // 第一步: 逐航迹确定每个目标时刻两侧的样本及插值权重, O(窗口 + 历史)
+    for (size_t slot = 0; slot < slots_.size(); ++slot) {
+        TrackSlot& s = slots_[slot];
+        if (s.count < 2 || s.fresh < static_cast<size_t>(config_.emit_stride)) {
+            continue;
+        }
+
+        const double step = SlotStep(s);
+        const double t_end = times_[SampleIndex(slot, s.count - 1)];
+        const double t_start = t_end - (kWindowSteps - 1) * step;
+        // 容忍浮点误差
+        if (times_[SampleIndex(slot, 0)] > t_start + 1e-6) {
+            continue;
+        }
+        if (skip && skip(s.key)) {
+            if (skipped) {
+                skipped->push_back(s.key);
+            }
+            s.fresh = 0;
+            continue;
+        }
+
+        size_t j = 0;
+        for (int k = 0; k < kWindowSteps; ++k) {
+            double tk = t_start + k * step;
+            while (j + 2 < s.count && times_[SampleIndex(slot, j + 1)] < tk) {
+                ++j;
+            }
+            size_t lo = SampleIndex(slot, j);
+            size_t hi = SampleIndex(slot, j + 1);
+            double t0 = times_[lo];
+            double t1 = times_[hi];
+            double w = (tk - t0) / (t1 - t0);
+            w = std::min(std::max(w, 0.0), 1.0);
+            lo_index_.push_back(static_cast<uint32_t>(lo));
+            hi_index_.push_back(static_cast<uint32_t>(hi));
+            weight_.push_back(static_cast<float>(w));
+        }
+
+        track_keys->push_back(s.key);
+        s.fresh = 0;
+    }
+    return track_keys->size();
+}
+
+void TrackWindowStore::ResampleReadyWindows(float* out) const {
+    const size_t rows = weight_.size();
+
+    // 第二步: 所有就绪航迹的全部时间步合并成一个平坦循环, 内层 14 维连续可向量化
+    const float* src = samples_.data();
+    for (size_t r = 0; r < rows; ++r) {
+        const float* a = src + static_cast<size_t>(lo_index_[r]) * kFeatureDim;
+        const float* b = src + static_cast<size_t>(hi_index_[r]) * kFeatureDim;
+        const float w = weight_[r];
+        float* dst = out + r * kFeatureDim;
+        for (int f = 0; f < kFeatureDim; ++f) {
+            dst[f] = a[f] + w * (b[f] - a[f]);
+        }
+    }
+
+    // 第三步: 角度特征折回 [0, 360)
+    for (size_t r = 0; r < rows; ++r) {
+        for (int f : kCircularFeatures) {
+            float& v = out[r * kFeatureDim + f];
+            v -= 360.0f * std::floor(v / 360.0f);
+        }
+    }
+}
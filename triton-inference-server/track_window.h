@@ -0,0 +1,107 @@
+#pragma once
+
+// 航迹时间窗口: 缓存每条航迹的带时间戳样本, 按固定步长重采样成 [20, 14] 窗口
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "track_message.h"
+
+// 模型输入: 20 个等间隔时间步, 每步 14 维特征
+constexpr int kWindowSteps = 20;
+constexpr int kFeatureDim = 14;
+
+// 特征列顺序, 必须与训练时保持一致
+enum TrackFeature {
+    kFeatRange = 0,      // 径向距离 m
+    kFeatAzimuth,        // 方位 度
+    kFeatElevation,      // 俯仰 度
+    kFeatRadialVel,      // 径向速度 m/s
+    kFeatAziVel,         // 方位速度 度/s
+    kFeatEleVel,         // 俯仰速度 度/s
+    kFeatSpeed,          // 全速度 m/s
+    kFeatAcc,            // 空间加速度 m/s^2
+    kFeatCourse,         // 航向 度
+    kFeatAmp,            // 幅度 dB
+    kFeatSnr,            // 信噪比 dB
+    kFeatRcs,            // RCS dB
+    kFeatAzErrStd,       // 方位误差均方根 度
+    kFeatEleErrStd,      // 俯仰误差均方根 度
+};
+static_assert(kFeatEleErrStd + 1 == kFeatureDim, "特征列数与模型输入不一致");
+
+// 从解码后的航迹点提取 14 维特征(已换算为物理单位)
+void ExtractTrackFeatures(const NetTrackItem_t& item, float* features);
+
+struct TrackWindowConfig {
+    double step_sec = 0.0;          // 重采样步长(秒), <=0 时使用航迹自身的 tas_prd
+    double default_step_sec = 0.1;  // tas_prd 缺失时的步长
+    size_t history_capacity = 64;   // 每条航迹保留的原始样本数
+    double max_gap_sec = 5.0;       // 相邻样本间隔超过此值视为断批, 清空历史
+    int emit_stride = 1;            // 每收到多少个新样本重新输出一次窗口
+};
+
+class TrackWindowStore {
+public:
+    explicit TrackWindowStore(const TrackWindowConfig& config = TrackWindowConfig());
+
+    // 写入一个航迹点, timestamp 为当日秒, step_hint 为航迹数据率(秒)
+    void AddSample(TrackKey track_key, double timestamp, const float* features,
+                   double step_hint = 0.0);
+
+    // 直接写入解码后的航迹报文条目
+    void AddTrackItem(const OcdHead_t& header, const NetTrackItem_t& item);
+
+    void RemoveTrack(TrackKey track_key);
+    void Clear();
+
+    // 对所有就绪航迹一次性重采样
+    // windows 输出为行主序 [N, 20, 14], track_keys 与之一一对应, 返回 N
+    size_t BuildReadyWindows(std::vector<TrackKey>* track_keys,
+                             std::vector<float>* windows);
+
+    // BuildReadyWindows 的两个步骤, 供调用方把窗口直接写入自己的缓冲(如共享内存):
+    // PlanReadyWindows 选出就绪航迹并计算插值位置, 返回 N;
+    // ResampleReadyWindows 把这 N 个窗口写入 out, out 至少容纳 N * 20 * 14 个 float
+    // skip 非空时, 就绪但 skip 返回 true 的航迹不输出窗口(同样计为已输出), 其键追加到 skipped
+    size_t PlanReadyWindows(std::vector<TrackKey>* track_keys,
+                            const std::function<bool(TrackKey)>& skip = nullptr,
+                            std::vector<TrackKey>* skipped = nullptr);
+    void ResampleReadyWindows(float* out) const;
+
+    size_t TrackCount() const { return slot_of_.size(); }
+    const TrackWindowConfig& config() const { return config_; }
+
+private:
+    struct TrackSlot {
+        TrackKey key = 0;
+        size_t head = 0;            // 下一个写入位置
+        size_t count = 0;           // 有效样本数
+        size_t fresh = 0;           // 上次输出后新增的样本数
+        double step = 0.0;          // 该航迹的重采样步长
+        double day_offset = 0.0;    // 跨零点时累加的秒数
+        double last_raw_time = -1.0;
+    };
+
+    size_t AcquireSlot(TrackKey track_key);
+    double SlotStep(const TrackSlot& slot) const;
+    // 第 slot 个航迹、时间顺序第 i 个样本在全局样本数组中的下标
+    size_t SampleIndex(size_t slot, size_t i) const;
+
+    TrackWindowConfig config_;
+    std::unordered_map<TrackKey, size_t> slot_of_;
+    std::vector<TrackSlot> slots_;
+    std::vector<size_t> free_slots_;
+
+    // SoA 存储: 每个槽位 history_capacity 个样本
+    std::vector<double> times_;     // [slot * cap + i]
+    std::vector<float> samples_;    // [(slot * cap + i) * 14 + f]
+
+    // 重采样中间结果, 复用避免每帧分配
+    std::vector<uint32_t> lo_index_;
+    std::vector<uint32_t> hi_index_;
+    std::vector<float> weight_;
+};
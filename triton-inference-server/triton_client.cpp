@@ -0,0 +1,583 @@
+#include "triton_client.h"
+
+#include <iostream>
+#include <memory>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <sstream>
+
+#include <json/json.h>
+
+#include "trace_recorder.h"
+
+namespace {
+
+// gRPC 统计转换成 JSON 后 64 位整数为字符串
+uint64_t JsonUint64(const Json::Value& value) {
+    if (value.isString()) {
+        try {
+            return std::stoull(value.asString());
+        } catch (const std::exception&) {
+            return 0;
+        }
+    }
+    return value.isNumeric() ? value.asUInt64() : 0;
+}
+
+}  // namespace
+
+TritonClient::TritonClient(const std::string& url, bool verbose, TransportKind transport)
+    : server_url_(url), verbose_(verbose) {
+    // 按协议创建客户端
+    tc::Error err;
+    client_ = InferTransport::Create(transport, server_url_, verbose_, &err);
+    if (!client_) {
+        std::cerr << "❌ 创建客户端失败 (" << TransportKindName(transport) << "): " << err << std::endl;
+    }
+}
+
+TritonClient::~TritonClient() {
+    if (client_ && arena_) {
+        client_->UnregisterSystemSharedMemory(region_name_);
+    }
+}
+
+std::string SharedMemoryRegionName(const SharedTensorArena& arena) {
+    const std::string& key = arena.key();
+    return (!key.empty() && key[0] == '/') ? key.substr(1) : key;
+}
+
+bool TritonClient::EnableSharedMemory(SharedTensorArena* arena, const std::string& region_name) {
+    if (!client_ || !arena || !arena->IsValid()) return false;
+
+    tc::Error err = client_->RegisterSystemSharedMemory(region_name, arena->key(), arena->byte_size());
+    if (!err.IsOk()) {
+        // 区域名含本进程号, 已被占用只可能是同号的进程崩溃前未注销, 注销后重试一次
+        client_->UnregisterSystemSharedMemory(region_name);
+        err = client_->RegisterSystemSharedMemory(region_name, arena->key(), arena->byte_size());
+    }
+    if (!err.IsOk()) {
+        std::cerr << "⚠️  注册共享内存失败, 使用 socket 传输: " << err << std::endl;
+        return false;
+    }
+    arena_ = arena;
+    region_name_ = region_name;
+    std::cout << "✅ 已注册共享内存 " << region_name << " (" << arena->key() << ", "
+              << arena->byte_size() / (1024 * 1024) << " MB)" << std::endl;
+    return true;
+}
+
+bool TritonClient::CheckServerHealth() {
+    if (!client_) {
+        std::cerr << "❌ 客户端未初始化" << std::endl;
+        return false;
+    }
+
+    bool live;
+    tc::Error err = client_->IsServerLive(&live);
+    if (!err.IsOk()) {
+        std::cerr << "❌ 连接服务器失败: " << err << std::endl;
+        return false;
+    }
+
+    if (live) {
+        std::cout << "✅ Triton 服务器运行正常" << std::endl;
+        return true;
+    } else {
+        std::cerr << "❌ Triton 服务器未响应" << std::endl;
+        return false;
+    }
+}
+
+bool TritonClient::GetModelInfo(const std::string& model_name) {
+    if (!client_) return false;
+
+    std::string model_metadata;
+    tc::Error err = client_->ModelMetadata(&model_metadata, model_name);
+    if (!err.IsOk()) {
+        std::cerr << "❌ 获取模型元数据失败: " << err << std::endl;
+        return false;
+    }
+
+    std::string model_config;
+    err = client_->ModelConfig(&model_config, model_name);
+    if (!err.IsOk()) {
+        std::cerr << "❌ 获取模型配置失败: " << err << std::endl;
+        return false;
+    }
+
+    std::cout << "\n📋 模型信息: " << model_name << std::endl;
+    std::cout << "元数据: " << model_metadata << std::endl;
+    std::cout << "配置: " << model_config << std::endl;
+
+    return true;
+}
+
+bool TritonClient::ListModels() {
+    if (!client_) return false;
+
+    std::string repository_index;
+    tc::Error err = client_->ModelRepositoryIndex(&repository_index);
+    if (!err.IsOk()) {
+        std::cerr << "❌ 获取模型列表失败: " << err << std::endl;
+        return false;
+    }
+
+    std::cout << "\n📦 模型仓库信息:" << std::endl;
+    std::cout << repository_index << std::endl;
+
+    return true;
+}
+
+bool TritonClient::IsModelReady(const std::string& model_name, const std::string& model_version) {
+    if (!client_) return false;
+
+    bool ready = false;
+    tc::Error err = client_->IsModelReady(&ready, model_name, model_version);
+    return err.IsOk() && ready;
+}
+
+bool TritonClient::FetchModelJson(const std::string& model_name, std::string* metadata,
+                                  std::string* config) {
+    if (!client_) return false;
+
+    tc::Error err = client_->ModelMetadata(metadata, model_name);
+    if (!err.IsOk()) {
+        std::cerr << "❌ 获取模型元数据失败: " << err << std::endl;
+        return false;
+    }
+    err = client_->ModelConfig(config, model_name);
+    if (!err.IsOk()) {
+        std::cerr << "❌ 获取模型配置失败: " << err << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool TritonClient::FetchRepositoryIndex(std::string* index) {
+    if (!client_) return false;
+
+    tc::Error err = client_->ModelRepositoryIndex(index);
+    if (!err.IsOk()) {
+        std::cerr << "❌ 获取模型列表失败: " << err << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool TritonClient::FetchModelStats(const std::string& model_name, const std::string& model_version,
+                                   ModelServerStats* stats) {
+    if (!client_) return false;
+
+    std::string json;
+    tc::Error err = client_->ModelStatistics(&json, model_name, model_version);
+    if (!err.IsOk()) {
+        return false;
+    }
+    Json::CharReaderBuilder builder;
+    std::istringstream stream(json);
+    Json::Value root;
+    std::string errors;
+    if (!Json::parseFromStream(builder, stream, &root, &errors)) {
+        return false;
+    }
+
+    *stats = ModelServerStats();
+    for (const Json::Value& model : root["model_stats"]) {
+        const Json::Value& inference = model["inference_stats"];
+        stats->success_count += JsonUint64(inference["success"]["count"]);
+        stats->queue_ns += JsonUint64(inference["queue"]["ns"]);
+        stats->compute_input_ns += JsonUint64(inference["compute_input"]["ns"]);
+        stats->compute_infer_ns += JsonUint64(inference["compute_infer"]["ns"]);
+        stats->compute_output_ns += JsonUint64(inference["compute_output"]["ns"]);
+    }
+    return true;
+}
+
+void TritonClient::SetTensorNames(const std::string& input_name, const std::string& output_name) {
+    input_name_ = input_name;
+    output_name_ = output_name;
+}
+
+std::vector<float> TritonClient::GenerateSampleData() {
+    std::vector<float> data(20 * 14);
+    
+    // 使用固定种子以获得可重现的结果
+    std::mt19937 gen(42);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+
+    // 生成随机数据
+    for (int i = 0; i < 20; ++i) {
+        for (int j = 0; j < 14; ++j) {
+            float base_value = dist(gen);
+            // 添加正弦波模式
+            float pattern = std::sin(2.0f * M_PI * i / 20.0f) * (j + 1) * 0.1f;
+            data[i * 14 + j] = base_value + pattern;
+        }
+    }
+
+    return data;
+}
+
+std::vector<float> TritonClient::Softmax(const std::vector<float>& logits) {
+    std::vector<float> result(logits.size());
+    
+    // 找到最大值以提高数值稳定性
+    float max_val = *std::max_element(logits.begin(), logits.end());
+    
+    // 计算exp和sum
+    float sum = 0.0f;
+    for (size_t i = 0; i < logits.size(); ++i) {
+        result[i] = std::exp(logits[i] - max_val);
+        sum += result[i];
+    }
+    
+    // 归一化
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] /= sum;
+    }
+    
+    return result;
+}
+
+bool TritonClient::PredictWithLabels(const std::string& model_name, 
+                      const std::vector<float>& input_data,
+                      const std::vector<std::string>& labels) {
+    if (!client_) return false;
+
+    // 输入数据形状 [1, 20, 14]
+    std::vector<int64_t> input_shape = {1, 20, 14};
+    
+    std::cout << "📥 输入数据形状: [" << input_shape[0] << ", " 
+              << input_shape[1] << ", " << input_shape[2] << "]" << std::endl;
+    std::cout << "📥 输入数据大小: " << input_data.size() << std::endl;
+
+    // 准备输入
+    tc::InferInput* input;
+    tc::Error err = tc::InferInput::Create(&input, input_name_, input_shape, "FP32");
+    if (!err.IsOk()) {
+        std::cerr << "❌ 创建输入失败: " << err << std::endl;
+        return false;
+    }
+
+    std::shared_ptr<tc::InferInput> input_ptr(input);
+
+    // 设置输入数据
+    err = input_ptr->AppendRaw(reinterpret_cast<const uint8_t*>(input_data.data()), 
+                               input_data.size() * sizeof(float));
+    if (!err.IsOk()) {
+        std::cerr << "❌ 设置输入数据失败: " << err << std::endl;
+        return false;
+    }
+
+    // 准备输出
+    tc::InferRequestedOutput* output;
+    err = tc::InferRequestedOutput::Create(&output, output_name_);
+    if (!err.IsOk()) {
+        std::cerr << "❌ 创建输出失败: " << err << std::endl;
+        return false;
+    }
+
+    std::shared_ptr<tc::InferRequestedOutput> output_ptr(output);
+
+    // 执行推理
+    std::vector<tc::InferInput*> inputs = {input_ptr.get()};
+    std::vector<const tc::InferRequestedOutput*> outputs = {output_ptr.get()};
+
+    tc::InferOptions options(model_name);
+    tc::InferResult* result;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    
+    err = client_->Infer(&result, options, inputs, outputs);
+    
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto inference_time = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count() / 1000.0;
+
+    if (!err.IsOk()) {
+        std::cerr << "❌ 推理失败: " << err << std::endl;
+        return false;
+    }
+
+    std::shared_ptr<tc::InferResult> result_ptr(result);
+
+    std::cout << "⚡ 推理时间: " << std::fixed << std::setprecision(4) 
+              << inference_time << " 毫秒" << std::endl;
+
+    // 获取输出数据
+    const uint8_t* output_buffer;
+    size_t output_byte_size;
+    err = result_ptr->RawData(output_name_, &output_buffer, &output_byte_size);
+    if (!err.IsOk()) {
+        std::cerr << "❌ 获取输出数据失败: " << err << std::endl;
+        return false;
+    }
+
+    // 转换输出数据
+    const float* output_data = reinterpret_cast<const float*>(output_buffer);
+    size_t output_size = output_byte_size / sizeof(float);
+
+    std::vector<float> raw_output(output_data, output_data + output_size);
+    
+    std::cout << "📤 输出大小: " << output_size << std::endl;
+    std::cout << "📤 原始输出: [";
+    for (size_t i = 0; i < raw_output.size(); ++i) {
+        std::cout << std::fixed << std::setprecision(4) << raw_output[i];
+        if (i < raw_output.size() - 1) std::cout << ", ";
+    }
+    std::cout << "]" << std::endl;
+
+    // 计算softmax概率
+    std::vector<float> probabilities = Softmax(raw_output);
+
+    // 获取预测结果
+    auto max_it = std::max_element(probabilities.begin(), probabilities.end());
+    int predicted_class = std::distance(probabilities.begin(), max_it);
+    float confidence = *max_it;
+
+    std::string predicted_label = (predicted_class < labels.size()) ? 
+                                 labels[predicted_class] : 
+                                 "Class_" + std::to_string(predicted_class);
+
+    // 显示结果
+    std::cout << "\n🎯 预测结果:" << std::endl;
+    std::cout << "预测类别: " << predicted_label << std::endl;
+    std::cout << "置信度: " << std::fixed << std::setprecision(4) << confidence << std::endl;
+    std::cout << "概率分布: ";
+    for (size_t i = 0; i < probabilities.size() && i < labels.size(); ++i) {
+        std::cout << labels[i] << "=" << std::fixed << std::setprecision(4) 
+                  << probabilities[i];
+        if (i < std::min(probabilities.size(), labels.size()) - 1) {
+            std::cout << ", ";
+        }
+    }
+    std::cout << std::endl;
+
+    return true;
+}
+
+bool TritonClient::InferBatch(const std::string& model_name, const float* input,
+                              size_t batch_size, std::vector<float>* output,
+                              const std::string& model_version) {
+    if (!TraceRecorder::Enabled()) {
+        return DoInferBatch(model_name, input, batch_size, output, model_version);
+    }
+
+    auto send = TraceClock::now();
+    bool ok = DoInferBatch(model_name, input, batch_size, output, model_version);
+    auto receive = TraceClock::now();
+
+    TraceArgs args;
+    args.batch = static_cast<int64_t>(TraceRecorder::ContextBatch());
+    args.value_name = "batch_size";
+    args.value = static_cast<double>(batch_size);
+    TraceRecorder::Instance().Complete("triton.request", "triton", send, receive, args);
+    return ok;
+}
+
+bool TritonClient::DoInferBatch(const std::string& model_name, const float* input,
+                                size_t batch_size, std::vector<float>* output,
+                                const std::string& model_version) {
+    if (!client_ || batch_size == 0) return false;
+
+    uint32_t slot;
+    size_t window;
+    if (arena_ && arena_->LocateInput(input, &slot, &window) &&
+        window + batch_size <= arena_->slot_windows()) {
+        return InferBatchShared(model_name, model_version, slot, window, batch_size, output);
+    }
+
+    std::vector<int64_t> input_shape = {static_cast<int64_t>(batch_size), 20, 14};
+
+    tc::InferInput* input_raw;
+    tc::Error err = tc::InferInput::Create(&input_raw, input_name_, input_shape, "FP32");
+    if (!err.IsOk()) {
+        std::cerr << "❌ 创建输入失败: " << err << std::endl;
+        return false;
+    }
+    std::shared_ptr<tc::InferInput> input_ptr(input_raw);
+
+    err = input_ptr->AppendRaw(reinterpret_cast<const uint8_t*>(input),
+                               batch_size * 20 * 14 * sizeof(float));
+    if (!err.IsOk()) {
+        std::cerr << "❌ 设置输入数据失败: " << err << std::endl;
+        return false;
+    }
+
+    tc::InferRequestedOutput* output_raw;
+    err = tc::InferRequestedOutput::Create(&output_raw, output_name_);
+    if (!err.IsOk()) {
+        std::cerr << "❌ 创建输出失败: " << err << std::endl;
+        return false;
+    }
+    std::shared_ptr<tc::InferRequestedOutput> output_ptr(output_raw);
+
+    tc::InferOptions options(model_name);
+    options.model_version_ = model_version;
+    std::vector<tc::InferInput*> inputs = {input_ptr.get()};
+    std::vector<const tc::InferRequestedOutput*> outputs = {output_ptr.get()};
+
+    tc::InferResult* result;
+    err = client_->Infer(&result, options, inputs, outputs);
+    if (!err.IsOk()) {
+        std::cerr << "❌ 推理失败: " << err << std::endl;
+        return false;
+    }
+    std::shared_ptr<tc::InferResult> result_ptr(result);
+
+    const uint8_t* output_buffer;
+    size_t output_byte_size;
+    err = result_ptr->RawData(output_name_, &output_buffer, &output_byte_size);
+    if (!err.IsOk()) {
+        std::cerr << "❌ 获取输出数据失败: " << err << std::endl;
+        return false;
+    }
+
+    const float* output_data = reinterpret_cast<const float*>(output_buffer);
+    output->assign(output_data, output_data + output_byte_size / sizeof(float));
+    return true;
+}
+
+bool TritonClient::InferBatchShared(const std::string& model_name, const std::string& model_version,
+                                    uint32_t slot, size_t window, size_t batch_size,
+                                    std::vector<float>* output) {
+    const size_t window_bytes = 20 * 14 * sizeof(float);
+    const size_t num_classes = arena_->num_classes();
+    std::vector<int64_t> input_shape = {static_cast<int64_t>(batch_size), 20, 14};
+
+    tc::InferInput* input_raw;
+    tc::Error err = tc::InferInput::Create(&input_raw, input_name_, input_shape, "FP32");
+    if (!err.IsOk()) {
+        std::cerr << "❌ 创建输入失败: " << err << std::endl;
+        return false;
+    }
+    std::shared_ptr<tc::InferInput> input_ptr(input_raw);
+
+    // 请求只携带区域名和偏移, 张量数据留在共享内存中
+    err = input_ptr->SetSharedMemory(region_name_, batch_size * window_bytes,
+                                     arena_->InputOffset(slot) + window * window_bytes);
+    if (!err.IsOk()) {
+        std::cerr << "❌ 设置共享内存输入失败: " << err << std::endl;
+        return false;
+    }
+
+    tc::InferRequestedOutput* output_raw;
+    err = tc::InferRequestedOutput::Create(&output_raw, output_name_);
+    if (!err.IsOk()) {
+        std::cerr << "❌ 创建输出失败: " << err << std::endl;
+        return false;
+    }
+    std::shared_ptr<tc::InferRequestedOutput> output_ptr(output_raw);
+
+    // 输出写到同一槽位输出区的对应位置, 与输入窗口一一对应
+    const size_t output_bytes = batch_size * num_classes * sizeof(float);
+    err = output_ptr->SetSharedMemory(region_name_, output_bytes,
+                                      arena_->OutputOffset(slot) + window * num_classes * sizeof(float));
+    if (!err.IsOk()) {
+        std::cerr << "❌ 设置共享内存输出失败: " << err << std::endl;
+        return false;
+    }
+
+    tc::InferOptions options(model_name);
+    options.model_version_ = model_version;
+    std::vector<tc::InferInput*> inputs = {input_ptr.get()};
+    std::vector<const tc::InferRequestedOutput*> outputs = {output_ptr.get()};
+
+    tc::InferResult* result;
+    err = client_->Infer(&result, options, inputs, outputs);
+    if (!err.IsOk()) {
+        std::cerr << "❌ 推理失败: " << err << std::endl;
+        return false;
+    }
+    std::shared_ptr<tc::InferResult> result_ptr(result);
+    err = result_ptr->RequestStatus();
+    if (!err.IsOk()) {
+        std::cerr << "❌ 推理失败: " << err << std::endl;
+        return false;
+    }
+
+    const float* output_data = arena_->OutputPtr(slot) + window * num_classes;
+    output->assign(output_data, output_data + batch_size * num_classes);
+    return true;
+}
+
+ModelStatsPoller::ModelStatsPoller(const std::string& url, TransportKind transport,
+                                   const std::string& model_name, int64_t interval_ms)
+    : control_(new TritonClient(url, false, transport)),
+      model_name_(model_name),
+      interval_ms_(std::max<int64_t>(interval_ms, 1)) {}
+
+ModelStatsPoller::~ModelStatsPoller() {
+    Stop();
+}
+
+bool ModelStatsPoller::Start() {
+    if (!control_->FetchModelStats(model_name_, "", &last_)) {
+        std::cerr << "⚠️  获取模型统计失败, 追踪中不含服务端耗时" << std::endl;
+        return false;
+    }
+    last_time_ = TraceClock::now();
+    thread_ = std::thread(&ModelStatsPoller::Run, this);
+    return true;
+}
+
+void ModelStatsPoller::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(stop_mutex_);
+        stop_ = true;
+    }
+    stop_cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void ModelStatsPoller::Run() {
+    TraceRecorder::Instance().SetThreadName("triton server (周期平均)");
+    std::unique_lock<std::mutex> lock(stop_mutex_);
+    while (!stop_cv_.wait_for(lock, std::chrono::milliseconds(interval_ms_),
+                              [this] { return stop_; })) {
+        lock.unlock();
+        PollOnce();
+        lock.lock();
+    }
+    lock.unlock();
+    PollOnce();
+}
+
+void ModelStatsPoller::PollOnce() {
+    ModelServerStats stats;
+    if (!control_->FetchModelStats(model_name_, "", &stats)) {
+        return;
+    }
+    auto now = TraceClock::now();
+    if (TraceRecorder::Enabled() && stats.success_count > last_.success_count) {
+        // Triton 不随响应返回单个请求的服务端耗时, 用相邻两次累计统计之差除以期间的请求数
+        const uint64_t requests = stats.success_count - last_.success_count;
+        const int64_t phases[] = {
+            static_cast<int64_t>((stats.queue_ns - last_.queue_ns) / requests),
+            static_cast<int64_t>((stats.compute_input_ns - last_.compute_input_ns) / requests),
+            static_cast<int64_t>((stats.compute_infer_ns - last_.compute_infer_ns) / requests),
+            static_cast<int64_t>((stats.compute_output_ns - last_.compute_output_ns) / requests),
+        };
+        const char* names[] = {"server.queue", "server.compute_input", "server.compute_infer",
+                               "server.compute_output"};
+        TraceRecorder& trace = TraceRecorder::Instance();
+        TraceArgs args;
+        args.value_name = "requests";
+        args.value = static_cast<double>(requests);
+        trace.Complete("server.interval", "server", last_time_, now, args);
+        // 各阶段的平均耗时从周期起点依次排开
+        auto begin = last_time_;
+        for (int i = 0; i < 4; ++i) {
+            auto end = begin + std::chrono::nanoseconds(phases[i]);
+            trace.Complete(names[i], "server", begin, end, args);
+            begin = end;
+        }
+        intervals_++;
+    }
+    last_ = stats;
+    last_time_ = now;
+}
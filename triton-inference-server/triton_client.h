@@ -0,0 +1,127 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "infer_transport.h"
+#include "shm_tensor_arena.h"
+
+// 服务端按模型累计的推理统计(成功请求数及各阶段累计耗时)
+struct ModelServerStats {
+    uint64_t success_count = 0;
+    uint64_t queue_ns = 0;
+    uint64_t compute_input_ns = 0;
+    uint64_t compute_infer_ns = 0;
+    uint64_t compute_output_ns = 0;
+};
+
+// 由共享内存键(如 "/track_windows_1234")得到服务端区域名, 多个客户端共用一个服务端时互不冲突
+std::string SharedMemoryRegionName(const SharedTensorArena& arena);
+
+class TritonClient {
+public:
+    TritonClient(const std::string& url = "localhost:8000", bool verbose = false,
+                 TransportKind transport = TransportKind::kHttp);
+    ~TritonClient();
+
+    TritonClient(const TritonClient&) = delete;
+    TritonClient& operator=(const TritonClient&) = delete;
+
+    bool CheckServerHealth();
+
+    bool GetModelInfo(const std::string& model_name);
+
+    bool ListModels();
+
+    // 不打印日志的查询接口, 供热启动使用
+    bool IsModelReady(const std::string& model_name, const std::string& model_version = "");
+    bool FetchModelJson(const std::string& model_name, std::string* metadata, std::string* config);
+    bool FetchRepositoryIndex(std::string* index);
+    // model_version 为空时累加该模型全部版本的统计
+    bool FetchModelStats(const std::string& model_name, const std::string& model_version,
+                         ModelServerStats* stats);
+
+    // 推理使用的输入/输出张量名, 默认为 "input" / "output"
+    void SetTensorNames(const std::string& input_name, const std::string& output_name);
+
+    // 不依赖连接, 进程内推理后端同样使用
+    static std::vector<float> GenerateSampleData();
+
+    static std::vector<float> Softmax(const std::vector<float>& logits);
+
+    bool PredictWithLabels(const std::string& model_name,
+                           const std::vector<float>& input_data,
+                           const std::vector<std::string>& labels = {"bird", "uav"});
+
+    // 批量推理, 不打印日志, 供流水线使用
+    // input 为行主序 [batch_size, 20, 14], output 写入 [batch_size, 类别数]
+    // 输入位于已注册的共享内存槽位内时, 输入输出都通过共享内存传递
+    // model_version 为空时由服务器按版本策略选择
+    // 开启请求追踪时记录请求区间, 服务端耗时由 ModelStatsPoller 在后台另行记录
+    bool InferBatch(const std::string& model_name, const float* input,
+                    size_t batch_size, std::vector<float>* output,
+                    const std::string& model_version = "");
+
+    // 以 region_name 向服务端注册 arena 所在的共享内存区域, 之后 InferBatch 自动识别其中的输入
+    // 区域名在服务端全局可见, 应与 arena->key() 一样按进程区分, 见 SharedMemoryRegionName
+    // 服务端与客户端不在同一主机时注册失败, 推理照常经 socket 传输
+    bool EnableSharedMemory(SharedTensorArena* arena, const std::string& region_name);
+
+private:
+    bool DoInferBatch(const std::string& model_name, const float* input, size_t batch_size,
+                      std::vector<float>* output, const std::string& model_version);
+
+    // InferBatch 的共享内存路径, 输入为 arena 中 slot 槽位从第 window 个窗口起的 batch_size 个窗口
+    bool InferBatchShared(const std::string& model_name, const std::string& model_version,
+                          uint32_t slot, size_t window, size_t batch_size,
+                          std::vector<float>* output);
+
+    std::string server_url_;
+    bool verbose_;
+    std::unique_ptr<InferTransport> client_;
+    std::string input_name_ = "input";
+    std::string output_name_ = "output";
+    SharedTensorArena* arena_ = nullptr;
+    std::string region_name_;
+};
+
+// 服务端耗时追踪: 后台线程经独立连接定期查询模型统计, 把相邻两次的差值按请求数平均后
+// 记为该周期的排队/计算区间; 推理线程不发起额外请求, 区间是周期内全部请求的平均值, 不对应单个批次
+class ModelStatsPoller {
+public:
+    ModelStatsPoller(const std::string& url, TransportKind transport, const std::string& model_name,
+                     int64_t interval_ms = 100);
+    ~ModelStatsPoller();
+
+    ModelStatsPoller(const ModelStatsPoller&) = delete;
+    ModelStatsPoller& operator=(const ModelStatsPoller&) = delete;
+
+    // 同步取得首次统计后启动后台线程, 查询失败时返回 false
+    bool Start();
+    // 再取一次统计覆盖最后一个周期后停止
+    void Stop();
+
+    uint64_t Intervals() const { return intervals_; }
+
+private:
+    void Run();
+    void PollOnce();
+
+    std::unique_ptr<TritonClient> control_;
+    std::string model_name_;
+    int64_t interval_ms_;
+    ModelServerStats last_;
+    std::chrono::steady_clock::time_point last_time_;
+    uint64_t intervals_ = 0;            // 记入追踪的周期数, 仅后台线程写入
+
+    std::thread thread_;
+    std::mutex stop_mutex_;
+    std::condition_variable stop_cv_;
+    bool stop_ = false;
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+// 编译期线上格式描述: 每个字段由 (字节偏移, 所在字的字节数, 位移, 位宽) 描述, 字段列表在编译期展开为
+// 解码/编码函数; 读写都是逐字节移位拼装, 不依赖编译器的位域布局和主机字节序, 也没有运行期分支
+// 多字节字按 WireEndian 解释, 位域的位移按字的数值计算(最低位为 0), 与字节序无关
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+enum class WireEndian { kLittle, kBig };
+
+namespace wire_detail {
+
+template <size_t Bytes> struct UnsignedOf;
+template <> struct UnsignedOf<1> { using type = uint8_t; };
+template <> struct UnsignedOf<2> { using type = uint16_t; };
+template <> struct UnsignedOf<4> { using type = uint32_t; };
+
+// 第 i 个字节在字中的位移
+template <WireEndian E, size_t Bytes>
+constexpr unsigned ByteShift(size_t i) {
+    return static_cast<unsigned>(8 * (E == WireEndian::kLittle ? i : Bytes - 1 - i));
+}
+
+template <WireEndian E, size_t Bytes, size_t... I>
+inline uint32_t LoadWord(const unsigned char* p, std::index_sequence<I...>) {
+    return (0u | ... | (static_cast<uint32_t>(p[I]) << ByteShift<E, Bytes>(I)));
+}
+
+template <WireEndian E, size_t Bytes, size_t... I>
+inline void StoreWord(unsigned char* p, uint32_t value, std::index_sequence<I...>) {
+    ((p[I] = static_cast<unsigned char>(value >> ByteShift<E, Bytes>(I))), ...);
+}
+
+}  // namespace wire_detail
+
+// 按 E 读写 Bytes 字节的无符号字, 编译器会把字节拼装合并为一次 (必要时带字节交换的) 载入/存储
+template <WireEndian E, size_t Bytes>
+inline typename wire_detail::UnsignedOf<Bytes>::type LoadWireWord(const char* p) {
+    return static_cast<typename wire_detail::UnsignedOf<Bytes>::type>(wire_detail::LoadWord<E, Bytes>(
+        reinterpret_cast<const unsigned char*>(p), std::make_index_sequence<Bytes>()));
+}
+
+template <WireEndian E, size_t Bytes>
+inline void StoreWireWord(char* p, typename wire_detail::UnsignedOf<Bytes>::type value) {
+    wire_detail::StoreWord<E, Bytes>(reinterpret_cast<unsigned char*>(p), value,
+                                     std::make_index_sequence<Bytes>());
+}
+
+// 单个字段: 位于记录内 Offset 处、长 Bytes 字节的字中, 占 [Shift, Shift + Bits) 位
+template <size_t Offset, size_t Bytes, unsigned Shift = 0, unsigned Bits = Bytes * 8, bool Signed = false>
+struct WireField {
+    static_assert(Bits > 0 && Shift + Bits <= Bytes * 8, "位域超出所在字");
+
+    using Word = typename wire_detail::UnsignedOf<Bytes>::type;
+    using Value = std::conditional_t<Signed, std::make_signed_t<Word>, Word>;
+
+    static constexpr size_t kOffset = Offset;
+    static constexpr size_t kBytes = Bytes;
+    // 字段在记录中的逻辑位区间, 用于检查字段列表是否重叠、是否覆盖整个记录
+    static constexpr size_t kBitBegin = Offset * 8 + Shift;
+    static constexpr size_t kBitEnd = kBitBegin + Bits;
+    static constexpr bool kWholeWord = Bits == Bytes * 8;
+    static constexpr Word kMask = static_cast<Word>(((uint64_t{1} << Bits) - 1) << Shift);
+
+    template <WireEndian E>
+    static Value Read(const char* record) {
+        const Word word = LoadWireWord<E, Bytes>(record + Offset);
+        if constexpr (kWholeWord) {
+            return static_cast<Value>(word);
+        } else if constexpr (Signed) {
+            // 移到最高位再算术右移完成符号扩展
+            return static_cast<Value>(static_cast<int64_t>(static_cast<uint64_t>(word >> Shift) << (64 - Bits)) >>
+                                      (64 - Bits));
+        } else {
+            return static_cast<Value>((word & kMask) >> Shift);
+        }
+    }
+
+    // 位域只改写自己的位, 同一个字中的其他字段保持不变
+    template <WireEndian E>
+    static void Write(char* record, Value value) {
+        if constexpr (kWholeWord) {
+            StoreWireWord<E, Bytes>(record + Offset, static_cast<Word>(value));
+        } else {
+            const Word word = LoadWireWord<E, Bytes>(record + Offset);
+            StoreWireWord<E, Bytes>(record + Offset, static_cast<Word>(
+                (word & ~kMask) | ((static_cast<Word>(value) << Shift) & kMask)));
+        }
+    }
+};
+
+// 字段列表, 按线上顺序排列; 只包含部分字段时解码/编码只触及这些字段所在的字节
+template <typename... Fields>
+struct WireSchema {
+    static_assert(sizeof...(Fields) > 0, "字段列表不能为空");
+
+    using Record = typename std::tuple_element<0, std::tuple<Fields...>>::type::Record;
+
+    // 字段按位区间升序且互不重叠
+    static constexpr bool Ordered() {
+        const size_t begin[] = {Fields::kBitBegin...};
+        const size_t end[] = {Fields::kBitEnd...};
+        for (size_t i = 1; i < sizeof...(Fields); ++i) {
+            if (begin[i] < end[i - 1]) return false;
+        }
+        return true;
+    }
+
+    // 字段首尾相接, 恰好覆盖 bytes 字节
+    static constexpr bool Covers(size_t bytes) {
+        const size_t begin[] = {Fields::kBitBegin...};
+        const size_t end[] = {Fields::kBitEnd...};
+        if (begin[0] != 0 || end[sizeof...(Fields) - 1] != bytes * 8) return false;
+        for (size_t i = 1; i < sizeof...(Fields); ++i) {
+            if (begin[i] != end[i - 1]) return false;
+        }
+        return true;
+    }
+
+    template <WireEndian E>
+    static void Decode(const char* data, Record* record) {
+        (Fields::template Decode<E>(data, record), ...);
+    }
+
+    template <WireEndian E>
+    static void Encode(const Record& record, char* data) {
+        (Fields::template Encode<E>(record, data), ...);
+    }
+};
+
+// 把字段绑定到结构体成员 Struct::member, 偏移和长度用 offsetof/sizeof 与结构体布局核对
+#define WIRE_MEMBER(Name, Struct, member, Offset, Bytes)                                             \
+    struct Name : WireField<Offset, Bytes, 0, Bytes * 8,                                             \
+                            std::is_signed<std::remove_reference_t<decltype(Struct::member)>>::value> { \
+        using Record = Struct;                                                                       \
+        static_assert(offsetof(Struct, member) == Offset, #Struct "::" #member " 偏移与线上格式不符");  \
+        static_assert(sizeof(Struct::member) == Bytes, #Struct "::" #member " 长度与线上格式不符");     \
+        template <WireEndian E> static void Decode(const char* data, Struct* record) {              \
+            record->member = Read<E>(data);                                                          \
+        }                                                                                            \
+        template <WireEndian E> static void Encode(const Struct& record, char* data) {              \
+            Write<E>(data, record.member);                                                           \
+        }                                                                                            \
+    }
+
+// 把字段绑定到位域成员; 位域没有地址, 偏移由所在 WireSchema 的覆盖检查间接核对
+#define WIRE_BITS(Name, Struct, member, Offset, Bytes, Shift, Bits)                                  \
+    struct Name : WireField<Offset, Bytes, Shift, Bits> {                                            \
+        using Record = Struct;                                                                       \
+        template <WireEndian E> static void Decode(const char* data, Struct* record) {              \
+            record->member = Read<E>(data);                                                          \
+        }                                                                                            \
+        template <WireEndian E> static void Encode(const Struct& record, char* data) {              \
+            Write<E>(data, record.member);                                                           \
+        }                                                                                            \
+    }